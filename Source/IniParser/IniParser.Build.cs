@@ -36,11 +36,18 @@ public class IniParser : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"IniParserCore",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
+
+		if (Target.bBuildEditor)
+		{
+			// Change notifications for UIniFileWatcherSubsystem; other targets poll file timestamps instead.
+			PrivateDependencyModuleNames.Add("DirectoryWatcher");
+		}
 		
 		
 		DynamicallyLoadedModuleNames.AddRange(
@@ -0,0 +1,261 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniCompression.h"
+
+#include "IniDataBuilder.h"
+#include "IniLibrary.h"
+#include "IniParserModule.h"
+#include "IniParserStats.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace IniCompression
+{
+	struct FHeader
+	{
+		uint32 Magic = FIniCompression::MAGIC;
+		uint8 Version = FIniCompression::VERSION;
+		uint8 Format = 0;
+		uint16 Reserved = 0;
+		uint32 ChunkSize = FIniCompression::CHUNK_SIZE;
+		uint64 UncompressedSize = 0;
+		TArray<uint32> CompressedSizes;
+
+		friend FArchive& operator<<(FArchive& Ar, FHeader& Header)
+		{
+			Ar << Header.Magic << Header.Version << Header.Format << Header.Reserved << Header.ChunkSize << Header.UncompressedSize;
+			Ar << Header.CompressedSizes;
+			return Ar;
+		}
+	};
+
+	/**
+	 * Read and validate the header of a compressed file, with the reader at the start of the file. Every size is checked
+	 * against the format limits and the file size before anything is allocated for it.
+	 *
+	 * @param IN Reader
+	 * @param IN FileSize
+	 * @param OUT OutHeader
+	 * @return False if the header is malformed or does not fit in the file
+	 */
+	static bool ReadHeader(FArchive& Reader, int64 FileSize, FHeader& OutHeader)
+	{
+		Reader << OutHeader.Magic << OutHeader.Version << OutHeader.Format << OutHeader.Reserved << OutHeader.ChunkSize << OutHeader.UncompressedSize;
+
+		// Chunks are decoded into int32-sized buffers, and the writer never produces more than MAX_int32 bytes of text.
+		if (Reader.IsError()
+			|| OutHeader.Version != FIniCompression::VERSION
+			|| OutHeader.Format > static_cast<uint8>(EIniCompressionFormat::Oodle)
+			|| OutHeader.ChunkSize == 0
+			|| OutHeader.ChunkSize > static_cast<uint32>(FIniCompression::CHUNK_SIZE)
+			|| OutHeader.UncompressedSize > static_cast<uint64>(MAX_int32))
+			return false;
+
+		// Same layout as the TArray written by operator<<, read by hand so the count is checked before allocating.
+		int32 NumChunks = 0;
+		Reader << NumChunks;
+
+		if (Reader.IsError() || NumChunks != FMath::DivideAndRoundUp<int64>(OutHeader.UncompressedSize, OutHeader.ChunkSize))
+			return false;
+
+		if (static_cast<int64>(NumChunks) * sizeof(uint32) > FileSize - Reader.Tell())
+			return false;
+
+		OutHeader.CompressedSizes.SetNumUninitialized(NumChunks);
+		int64 TotalCompressedSize = 0;
+
+		for (uint32& CompressedSize : OutHeader.CompressedSizes)
+		{
+			Reader << CompressedSize;
+
+			if (CompressedSize > static_cast<uint32>(MAX_int32))
+				return false;
+
+			TotalCompressedSize += CompressedSize;
+		}
+
+		return !Reader.IsError() && TotalCompressedSize <= FileSize - Reader.Tell();
+	}
+}
+
+FName FIniCompression::GetFormatName(EIniCompressionFormat Format)
+{
+	switch (Format)
+	{
+		case EIniCompressionFormat::Gzip: return NAME_Gzip;
+		case EIniCompressionFormat::LZ4: return NAME_LZ4;
+		case EIniCompressionFormat::Oodle: return NAME_Oodle;
+		default: return NAME_Zlib;
+	}
+}
+
+bool FIniCompression::ReadFromFile(const FString& FilePath, FIniData& OutData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIniCompression::ReadFromFile);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+
+	if (!Reader)
+	{
+		UE_LOG(LogIniParser, Warning, TEXT("ERROR: Can not read the file because it was not found."));
+		UE_LOG(LogIniParser, Warning, TEXT("Expected file location: %s"), *FilePath);
+		return false;
+	}
+
+	const int64 FileSize = Reader->TotalSize();
+
+	uint32 Magic = 0;
+
+	if (FileSize >= static_cast<int64>(sizeof(Magic)))
+	{
+		*Reader << Magic;
+		Reader->Seek(0);
+	}
+
+	// Plain text files go through the regular path.
+	if (Magic != MAGIC)
+	{
+		Reader.Reset();
+		OutData = UIniLibrary::ReadIniFromFile(FilePath);
+		return true;
+	}
+
+	IniCompression::FHeader Header;
+
+	if (!IniCompression::ReadHeader(*Reader, FileSize, Header))
+	{
+		UE_LOG(LogIniParser, Warning, TEXT("ERROR: Unsupported compressed .ini header in %s"), *FilePath);
+		return false;
+	}
+
+	const FName FormatName = GetFormatName(static_cast<EIniCompressionFormat>(Header.Format));
+
+	TArray<FIniEntryCounts> EntryCounts;
+	EntryCounts.AddDefaulted();
+
+	OutData = FIniData();
+
+	FIniDataBuilder Builder{ OutData, EntryCounts };
+	FIniUtf8DataBuilder Utf8Builder{ Builder };
+
+	TArray<uint8> Compressed;
+
+	// Decoded text; the unfinished tail of a chunk is carried over to the next one.
+	TArray<char> Window;
+	int32 Carry = 0;
+	int64 Remaining = static_cast<int64>(Header.UncompressedSize);
+	int64 NumLines = 0;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Header.CompressedSizes.Num(); ChunkIndex++)
+	{
+		const int32 CompressedSize = static_cast<int32>(Header.CompressedSizes[ChunkIndex]);
+		const int32 ChunkSize = static_cast<int32>(FMath::Min<int64>(Header.ChunkSize, Remaining));
+
+		Compressed.SetNumUninitialized(CompressedSize, false);
+		Reader->Serialize(Compressed.GetData(), CompressedSize);
+
+		Window.SetNumUninitialized(Carry + ChunkSize, false);
+
+		if (Reader->IsError() || !FCompression::UncompressMemory(FormatName, Window.GetData() + Carry, ChunkSize, Compressed.GetData(), CompressedSize))
+		{
+			UE_LOG(LogIniParser, Warning, TEXT("ERROR: Failed to decompress chunk %d of %s"), ChunkIndex, *FilePath);
+			return false;
+		}
+
+		Remaining -= ChunkSize;
+
+		const char* Begin = Window.GetData();
+		const char* End = Begin + Window.Num();
+		const char* Tail = End;
+
+		// Entries that may continue in the next chunk (including multi-line values) are carried over whole.
+		if (Remaining > 0)
+			Tail = IniParserCore::TokenizeComplete(Begin, End, Utf8Builder);
+		else
+			IniParserCore::Tokenize(Begin, End, Utf8Builder);
+
+		for (const char* Char = Begin; Char < Tail; ++Char)
+			NumLines += *Char == '\n';
+
+		Carry = static_cast<int32>(End - Tail);
+
+		if (Carry > 0)
+			FMemory::Memmove(Window.GetData(), Tail, Carry);
+	}
+
+	if (Remaining != 0)
+	{
+		UE_LOG(LogIniParser, Warning, TEXT("ERROR: Truncated compressed .ini file %s"), *FilePath);
+		return false;
+	}
+
+	if (FIniParserStats::IsEnabled())
+		FIniParserStats::RecordRead(FilePath, FileSize, NumLines + (Header.UncompressedSize > 0), Builder.NumEntries, FPlatformTime::Seconds() - StartTime);
+
+	return true;
+}
+
+bool FIniCompression::WriteToFile(const FString& FilePath, const FIniData& Data, EIniCompressionFormat Format)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIniCompression::WriteToFile);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FName FormatName = GetFormatName(Format);
+
+	const FString Text = UIniLibrary::ParseIniToString(Data);
+	const FTCHARToUTF8 Utf8(*Text, Text.Len());
+
+	IniCompression::FHeader Header;
+	Header.Format = static_cast<uint8>(Format);
+	Header.UncompressedSize = static_cast<uint64>(Utf8.Length());
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Utf8.Length(), CHUNK_SIZE);
+
+	TArray<uint8> Payload;
+	Payload.Reserve(FCompression::CompressMemoryBound(FormatName, FMath::Min(Utf8.Length(), CHUNK_SIZE)) * NumChunks);
+
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		const int32 Offset = ChunkIndex * CHUNK_SIZE;
+		const int32 ChunkSize = FMath::Min(CHUNK_SIZE, Utf8.Length() - Offset);
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, ChunkSize);
+		const int32 PayloadOffset = Payload.AddUninitialized(CompressedSize);
+
+		if (!FCompression::CompressMemory(FormatName, Payload.GetData() + PayloadOffset, CompressedSize, Utf8.Get() + Offset, ChunkSize))
+		{
+			UE_LOG(LogIniParser, Warning, TEXT("ERROR: Failed to compress %s with %s"), *FilePath, *FormatName.ToString());
+			return false;
+		}
+
+		Payload.SetNum(PayloadOffset + CompressedSize, false);
+		Header.CompressedSizes.Add(static_cast<uint32>(CompressedSize));
+	}
+
+	const FString Directory = FPaths::GetPath(FilePath);
+
+	if (!FPaths::DirectoryExists(*Directory))
+		IFileManager::Get().MakeDirectory(*Directory, true);
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+
+	if (!Writer)
+		return false;
+
+	*Writer << Header;
+	Writer->Serialize(Payload.GetData(), Payload.Num());
+
+	const int64 FileSize = Writer->Tell();
+	const bool bSuccess = Writer->Close();
+
+	if (bSuccess && FIniParserStats::IsEnabled())
+		FIniParserStats::RecordWrite(FilePath, FileSize, 0, FPlatformTime::Seconds() - StartTime);
+
+	return bSuccess;
+}
\ No newline at end of file
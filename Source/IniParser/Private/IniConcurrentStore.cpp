@@ -0,0 +1,62 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniConcurrentStore.h"
+
+FIniConcurrentStore::FIniConcurrentStore(FIniData InitialData)
+	: Current(MakeSnapshot(MoveTemp(InitialData)))
+	, Version(1)
+{ }
+
+void FIniConcurrentStore::Publish(FIniData NewData)
+{
+	// Parse pending sections before taking the lock.
+	FSnapshot NewSnapshot = MakeSnapshot(MoveTemp(NewData));
+
+	FScopeLock Lock(&WriterLock);
+	Exchange(MoveTemp(NewSnapshot));
+}
+
+FIniConcurrentStore::FSnapshot FIniConcurrentStore::MakeSnapshot(FIniData&& Data)
+{
+	// Snapshots are read from many threads, so lazily loaded sections must be parsed before publishing.
+	Data.Materialize();
+
+	return MakeShared<FIniData, ESPMode::ThreadSafe>(MoveTemp(Data));
+}
+
+void FIniConcurrentStore::Exchange(FSnapshot NewSnapshot)
+{
+	// Swap under the read/write lock, but let the previous version die outside of it.
+	FSnapshot Previous = MoveTemp(NewSnapshot);
+	{
+		FWriteScopeLock Lock(SnapshotLock);
+		Swap(Current, Previous);
+		Version.fetch_add(1, std::memory_order_release);
+	}
+}
+
+FIniConcurrentStore::FSnapshot FIniConcurrentStore::GetSnapshot() const
+{
+	uint64 SnapshotVersion;
+	return GetSnapshot(SnapshotVersion);
+}
+
+FIniConcurrentStore::FSnapshot FIniConcurrentStore::GetSnapshot(uint64& OutVersion) const
+{
+	FReadScopeLock Lock(SnapshotLock);
+	OutVersion = Version.load(std::memory_order_relaxed);
+	return Current;
+}
+
+FIniConcurrentStore::FReader::FReader(const FIniConcurrentStore& InStore)
+	: Store(InStore)
+	, Snapshot(InStore.GetSnapshot(SnapshotVersion))
+{ }
+
+const FIniData& FIniConcurrentStore::FReader::Get()
+{
+	if (Store.Version.load(std::memory_order_acquire) != SnapshotVersion)
+		Snapshot = Store.GetSnapshot(SnapshotVersion);
+
+	return Snapshot.Get();
+}
\ No newline at end of file
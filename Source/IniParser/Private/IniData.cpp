@@ -1,48 +1,365 @@
 // Copyright 2023 MrRobin. All Rights Reserved.
 
 #include "IniData.h"
+#include "IniReadTelemetry.h"
+#include "IniDataBuilder.h"
 #include "Kismet/KismetStringLibrary.h"
 
+void FIniData::Reserve(int32 NumSections, int32 NumProperties, int32 NumComments)
+{
+	Sections.Reserve(NumSections);
+
+	if (KeyMode == EIniKeyMode::CaseSensitive)
+		KeyedProperties.Reserve(NumProperties);
+	else
+		Properties.Reserve(NumProperties);
+
+	Comments.Reserve(NumComments);
+}
+
+void FIniData::Materialize()
+{
+	TArray<FName> Pending;
+	PendingSections.GetKeys(Pending);
+
+	for (const FName& SectionName : Pending)
+		MaterializeSection(SectionName);
+}
+
+bool FIniData::Serialize(FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		PendingSections.Reset();
+		LazySource.Reset();
+	}
+	else if (Ar.IsSaving() && !Ar.IsObjectReferenceCollector())
+	{
+		Materialize();
+		StoreKeyedProperties();
+	}
+
+	return false;
+}
+
+void FIniData::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+		RestoreKeyedProperties();
+	else
+		KeyedPropertyRecords.Empty();
+}
+
+bool FIniData::ExportTextItem(FString& ValueStr, const FIniData& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
+{
+	FIniData& Mutable = const_cast<FIniData&>(*this);
+	Mutable.Materialize();
+	Mutable.StoreKeyedProperties();
+
+	// Without the native override this is the regular property export, now including the records.
+	StaticStruct()->ExportText(ValueStr, this, &DefaultValue, Parent, PortFlags, ExportRootScope, false);
+
+	Mutable.KeyedPropertyRecords.Empty();
+	return true;
+}
+
+bool FIniData::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+{
+	PendingSections.Reset();
+	LazySource.Reset();
+
+	const TCHAR* Result = StaticStruct()->ImportText(Buffer, this, Parent, PortFlags, ErrorText, TEXT("IniData"), false);
+
+	if (Result == nullptr)
+	{
+		KeyedPropertyRecords.Empty();
+		return false;
+	}
+
+	Buffer = Result;
+	RestoreKeyedProperties();
+
+	return true;
+}
+
+void FIniData::StoreKeyedProperties()
+{
+	KeyedPropertyRecords.Reset();
+
+	auto AddRecords = [this](bool bGlobal, const FName& SectionName, const FIniKeyTable& Table)
+	{
+		for (const FIniKeyedProperty& Entry : Table.GetEntries())
+		{
+			FIniKeyedPropertyRecord& Record = KeyedPropertyRecords.AddDefaulted_GetRef();
+			Record.bGlobal = bGlobal;
+			Record.Section = SectionName;
+			Record.Key = Entry.Key;
+			Record.Property = Entry.Property;
+		}
+	};
+
+	AddRecords(true, NAME_None, KeyedProperties);
+
+	for (const auto& SectionPair : Sections)
+		AddRecords(false, SectionPair.Key, SectionPair.Value.GetKeyedProperties());
+}
+
+void FIniData::RestoreKeyedProperties()
+{
+	KeyedProperties.Reset();
+
+	for (auto& SectionPair : Sections)
+		SectionPair.Value.GetKeyedProperties().Reset();
+
+	for (FIniKeyedPropertyRecord& Record : KeyedPropertyRecords)
+	{
+		FIniKeyTable& Table = Record.bGlobal ? KeyedProperties : Sections.FindOrAdd(Record.Section).GetKeyedProperties();
+		Table.FindOrAdd(Record.Key, FString()) = MoveTemp(Record.Property);
+	}
+
+	KeyedPropertyRecords.Empty();
+}
+
+void FIniData::MaterializeSection(const FName& SectionName)
+{
+	if (PendingSections.IsEmpty())
+		return;
+
+	TArray<FIniLazySectionRange, TInlineAllocator<1>> Ranges;
+
+	if (!PendingSections.RemoveAndCopyValue(SectionName, Ranges))
+		return;
+
+	FIniSection& Section = Sections.FindOrAdd(SectionName);
+
+	int32 NumProperties = 0;
+	int32 NumComments = 0;
+
+	for (const FIniLazySectionRange& Range : Ranges)
+	{
+		NumProperties += Range.NumProperties;
+		NumComments += Range.NumComments;
+	}
+
+	Section.Reserve(NumProperties, NumComments, KeyMode);
+
+	// Bodies never contain a header, so the builder stays in this section.
+	TArray<FIniEntryCounts> EntryCounts;
+	EntryCounts.AddDefaulted();
+
+	FIniDataBuilder Builder{ *this, EntryCounts, &Section };
+	const TCHAR* Source = **LazySource;
+
+	for (const FIniLazySectionRange& Range : Ranges)
+		IniParserCore::Tokenize(Source + Range.Begin, Source + Range.End, Builder);
+
+	if (PendingSections.IsEmpty())
+		LazySource.Reset();
+}
+
+int32 FIniLazyIndexer::Index(FIniData& Data, FString&& Source, EIniKeyMode KeyMode, int32& OutNumEntries)
+{
+	Data.SetKeyMode(KeyMode);
+
+	TSharedRef<FString, ESPMode::ThreadSafe> SharedSource = MakeShared<FString, ESPMode::ThreadSafe>(MoveTemp(Source));
+
+	const TCHAR* Begin = **SharedSource;
+	const TCHAR* End = Begin + SharedSource->Len();
+	const TCHAR* Cursor = Begin;
+
+	TArray<FIniEntryCounts> EntryCounts;
+	EntryCounts.AddDefaulted();
+
+	FIniDataBuilder GlobalBuilder{ Data, EntryCounts };
+
+	/** Body of the section being scanned, null while in the global scope */
+	FIniLazySectionRange* Range = nullptr;
+	int32 NumLines = 0;
+	int32 NumDeferredEntries = 0;
+
+	while (Cursor < End)
+	{
+		// Whole entries, so a line inside a multi-line value is never taken for a section header.
+		const TCHAR* LineEnd = IniParserCore::FindEntryEnd(Cursor, End);
+		const IniParserCore::TSpan<TCHAR> Line = IniParserCore::Trim(Cursor, LineEnd);
+		const TCHAR* NextLine = LineEnd < End ? LineEnd + 1 : End;
+
+		NumLines++;
+
+		for (const TCHAR* Char = Line.Begin; Char < Line.End; ++Char)
+			NumLines += *Char == TEXT('\n');
+
+		if (Line.IsEmpty())
+		{
+			Cursor = NextLine;
+			continue;
+		}
+
+		if (*Line.Begin == SECTION_START_CHAR)
+		{
+			const TCHAR* Close = IniParserCore::Find(Line.Begin + 1, Line.End, TEXT(']'));
+
+			// Same rule as the tokenizer: a header without ']' is dropped.
+			if (Close != Line.End)
+			{
+				if (Range)
+					Range->End = static_cast<int32>(Cursor - Begin);
+
+				const IniParserCore::TSpan<TCHAR> Name = IniParserCore::Trim(Line.Begin + 1, Close);
+				const FName SectionName(static_cast<int32>(Name.Len()), Name.Begin);
+
+				if (!Data.Sections.Contains(SectionName))
+					Data.Sections.Add(SectionName);
+
+				NumDeferredEntries++;
+				Range = &Data.PendingSections.FindOrAdd(SectionName).AddDefaulted_GetRef();
+				Range->Begin = static_cast<int32>(NextLine - Begin);
+				Range->End = static_cast<int32>(End - Begin);
+			}
+		}
+		else if (Range)
+		{
+			NumDeferredEntries++;
+
+			if (*Line.Begin == COMMENT_CHAR)
+				Range->NumComments++;
+			else
+				Range->NumProperties++;
+		}
+		else
+		{
+			IniParserCore::TokenizeLine(Line.Begin, Line.End, GlobalBuilder);
+		}
+
+		Cursor = NextLine;
+	}
+
+	if (!Data.PendingSections.IsEmpty())
+		Data.LazySource = SharedSource;
+
+	OutNumEntries = GlobalBuilder.NumEntries + NumDeferredEntries;
+	return NumLines;
+}
+
 FIniSection* FIniData::FindSection(const FName& Key)
 {
+	MaterializeSection(Key);
+
 	return Sections.Find(Key);
 }
 
 FIniSection FIniData::FindRefSection(const FName& Key)
 {
+	MaterializeSection(Key);
+
 	return Sections.FindRef(Key);
 }
 
 FIniSection& FIniData::FindOrAddSection(const FName& Key)
 {
+	MaterializeSection(Key);
+
 	return Sections.FindOrAdd(Key, FIniSection());
 }
 
 FIniSection& FIniData::AddSection(const FName& Key)
 {
+	PendingSections.Remove(Key);
+
 	return Sections.Add(Key, FIniSection());
 }
 
+FIniSection& FIniData::AddSection(const FName& Key, FIniSection&& Section)
+{
+	PendingSections.Remove(Key);
+
+	return Sections.Add(Key, MoveTemp(Section));
+}
+
 FIniSection& FIniData::GetSection(const FName& SectionName)
 {
+	MaterializeSection(SectionName);
+
 	return Sections[SectionName];
 }
 
+bool FIniData::RemoveSection(const FName& SectionName)
+{
+	PendingSections.Remove(SectionName);
+
+	return Sections.Remove(SectionName) > 0;
+}
+
 void FIniData::AddComment(FString Comment)
 {
-	Comments.Add(Comment);
+	Comments.Add(MoveTemp(Comment));
 }
 
 void FIniData::AddUniqueComment(FString Comment)
 {
-	Comments.AddUnique(Comment);
+	Comments.AddUnique(MoveTemp(Comment));
+}
+
+bool FIniData::RemoveComment(const FString& Comment)
+{
+	const int32 Index = Comments.IndexOfByPredicate([&Comment](const FString& Existing)
+	{
+		return Existing.Equals(Comment, ESearchCase::CaseSensitive);
+	});
+
+	if (Index == INDEX_NONE)
+		return false;
+
+	Comments.RemoveAt(Index);
+	return true;
 }
 
 FIniProperty* FIniData::FindProperty(const FName& Key)
 {
+	FIniReadTelemetry::RecordRead(NAME_None, Key);
+
 	return Properties.Find(Key);
 }
 
+FIniProperty* FIniData::FindPropertyByString(FStringView Key)
+{
+	if (FIniProperty* Property = KeyedProperties.IsEmpty() ? nullptr : KeyedProperties.Find(Key))
+		return Property;
+
+	const FName Name(Key.Len(), Key.GetData(), FNAME_Find);
+
+	// NAME_None means the lookup failed, unless the key is "None" itself.
+	if (Name.IsNone() && !Key.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+		return nullptr;
+
+	return Properties.Find(Name);
+}
+
+bool FIniData::HasKeyedProperties() const
+{
+	if (KeyMode == EIniKeyMode::CaseSensitive || !KeyedProperties.IsEmpty())
+		return true;
+
+	// Pending sections are parsed with the document's key mode, checked above, so only sections that exist already can add keyed properties.
+	for (const auto& SectionPair : Sections)
+	{
+		if (!SectionPair.Value.GetKeyedProperties().IsEmpty())
+			return true;
+	}
+
+	return false;
+}
+
+FIniProperty& FIniData::FindOrAddKeyedProperty(FStringView Key, FString&& Value)
+{
+	return KeyedProperties.FindOrAdd(Key, MoveTemp(Value));
+}
+
+bool FIniData::RemoveKeyedProperty(FStringView Key)
+{
+	return KeyedProperties.Remove(Key);
+}
+
 FIniProperty FIniData::FindRefProperty(const FName& Key)
 {
 	return Properties.FindRef(Key);
@@ -50,7 +367,18 @@ FIniProperty FIniData::FindRefProperty(const FName& Key)
 
 FIniProperty& FIniData::FindOrAddProperty(const FName& Key, const FString& Value)
 {
-	return Properties.FindOrAdd(Key, FIniProperty(Value));
+	if (FIniProperty* Property = Properties.Find(Key))
+		return *Property;
+
+	return Properties.Add(Key, FIniProperty(Value));
+}
+
+FIniProperty& FIniData::FindOrAddProperty(const FName& Key, FString&& Value)
+{
+	if (FIniProperty* Property = Properties.Find(Key))
+		return *Property;
+
+	return Properties.Add(Key, FIniProperty(MoveTemp(Value)));
 }
 
 FIniProperty& FIniData::AddProperty(const FName& Key, const FString& Value)
@@ -58,12 +386,41 @@ FIniProperty& FIniData::AddProperty(const FName& Key, const FString& Value)
 	return Properties.Add(Key, FIniProperty(Value));
 }
 
+FIniProperty& FIniData::AddProperty(const FName& Key, FString&& Value)
+{
+	return Properties.Add(Key, FIniProperty(MoveTemp(Value)));
+}
+
 FIniProperty& FIniData::GetProperty(const FName& PropertyName)
 {
 	return Properties[PropertyName];
 }
 
+bool FIniData::RemoveProperty(const FName& PropertyName)
+{
+	return Properties.Remove(PropertyName) > 0;
+}
+
+TMap<FName, FIniSection> FIniData::ExtractSections()
+{
+	Materialize();
+
+	return MoveTemp(Sections);
+}
+
+TMap<FName, FIniProperty> FIniData::ExtractProperties()
+{
+	return MoveTemp(Properties);
+}
+
+TArray<FString> FIniData::ExtractComments()
+{
+	return MoveTemp(Comments);
+}
+
 FIniSection& FIniData::operator[](const FName& SectionName)
 {
+	MaterializeSection(SectionName);
+
 	return Sections[SectionName];
 }
\ No newline at end of file
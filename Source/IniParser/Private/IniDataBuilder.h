@@ -0,0 +1,220 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+
+#include "IniParserCore/IniTokenizer.h"
+
+static const char& COMMENT_CHAR = ';';
+static const char& SECTION_START_CHAR = '[';
+static const char& TAB_CHAR = '\t';
+static const char& NEWLINE_CHAR = '\n';
+static const char& SPACE_CHAR = ' ';
+
+/* Number of entries found under one section header, used to size containers before parsing */
+struct FIniEntryCounts
+{
+	int32 NumProperties = 0;
+	int32 NumComments = 0;
+};
+
+/**
+ * Cheap pre-pass over the source that counts properties and comments per section (index 0 is the global scope).
+ * Only the first non-blank character of each line is inspected, so lines inside multi-line values are counted too;
+ * the counts only size containers.
+ *
+ * @return Number of lines in the source
+ */
+inline int32 CountEntries(const FString& String, TArray<FIniEntryCounts>& OutCounts)
+{
+	OutCounts.AddDefaulted();
+
+	int32 NumLines = String.IsEmpty() ? 0 : 1;
+	bool bLineStart = true;
+
+	for (TCHAR Char : String)
+	{
+		if (Char == NEWLINE_CHAR)
+		{
+			NumLines++;
+			bLineStart = true;
+			continue;
+		}
+
+		if (!bLineStart || Char == SPACE_CHAR || Char == TAB_CHAR || Char == TEXT('\r'))
+			continue;
+
+		bLineStart = false;
+
+		if (Char == SECTION_START_CHAR)
+			OutCounts.AddDefaulted();
+		else if (Char == COMMENT_CHAR)
+			OutCounts.Last().NumComments++;
+		else
+			OutCounts.Last().NumProperties++;
+	}
+
+	return NumLines;
+}
+
+/* Fills .ini data from IniParserCore tokens */
+struct FIniDataBuilder
+{
+	typedef IniParserCore::TSpan<TCHAR> FSpan;
+
+	FIniData& Data;
+	const TArray<FIniEntryCounts>& EntryCounts;
+
+	/** Null while in the global scope */
+	FIniSection* CurrentSection = nullptr;
+	int32 SectionIndex = 0;
+
+	/** Comments, section headers and property lines seen so far, reported as "entries read" by FIniParserStats */
+	int32 NumEntries = 0;
+
+	void OnComment(FSpan Text)
+	{
+		NumEntries++;
+
+		FString Comment(static_cast<int32>(Text.Len()), Text.Begin);
+
+		if (CurrentSection)
+			CurrentSection->AddComment(MoveTemp(Comment));
+		else
+			Data.AddComment(MoveTemp(Comment));
+	}
+
+	void OnSection(FSpan Name)
+	{
+		NumEntries++;
+
+		const FName SectionName(static_cast<int32>(Name.Len()), Name.Begin);
+		const FIniEntryCounts& Counts = EntryCounts[FMath::Min(++SectionIndex, EntryCounts.Num() - 1)];
+
+		if ((CurrentSection = Data.FindSection(SectionName)) == nullptr)
+		{
+			// Size every container once up front, so filling it never has to rehash or grow.
+			CurrentSection = &Data.AddSection(SectionName);
+			CurrentSection->Reserve(Counts.NumProperties, Counts.NumComments, Data.GetKeyMode());
+		}
+	}
+
+	void OnProperty(FSpan Key, FSpan RawValue)
+	{
+		NumEntries++;
+
+		const IniParserCore::EArrayOp ArrayOp = IniParserCore::SplitArrayOp(Key);
+
+		FString Value;
+		Value.Reserve(static_cast<int32>(RawValue.Len()));
+
+		IniParserCore::DecodeValue(RawValue, [&Value](const TCHAR* Chars, size_t Len)
+		{
+			Value.AppendChars(Chars, static_cast<int32>(Len));
+		});
+
+		// Case-sensitive documents keep the key text, so no FName is created for it.
+		if (Data.GetKeyMode() == EIniKeyMode::CaseSensitive)
+		{
+			OnKeyedProperty(FStringView(Key.Begin, static_cast<int32>(Key.Len())), ArrayOp, MoveTemp(Value));
+			return;
+		}
+
+		const FName PropertyName(static_cast<int32>(Key.Len()), Key.Begin);
+
+		switch (ArrayOp)
+		{
+			case IniParserCore::EArrayOp::None:
+				if (CurrentSection)
+					CurrentSection->FindOrAddProperty(PropertyName, MoveTemp(Value));
+				else
+					Data.FindOrAddProperty(PropertyName, MoveTemp(Value));
+				break;
+
+			case IniParserCore::EArrayOp::Add:
+				FindOrAddArrayProperty(PropertyName).AddValue(MoveTemp(Value));
+				break;
+
+			// Removing from a missing key does not create it.
+			case IniParserCore::EArrayOp::Remove:
+				if ((CurrentSection ? CurrentSection->GetProperties() : Data.GetProperties()).Contains(PropertyName))
+					FindOrAddArrayProperty(PropertyName).RemoveValue(Value);
+				break;
+		}
+	}
+
+	void OnKeyedProperty(FStringView Key, IniParserCore::EArrayOp ArrayOp, FString&& Value)
+	{
+		FIniKeyTable& Table = CurrentSection ? CurrentSection->GetKeyedProperties() : Data.GetKeyedProperties();
+
+		switch (ArrayOp)
+		{
+			case IniParserCore::EArrayOp::None:
+				Table.FindOrAdd(Key, MoveTemp(Value));
+				break;
+
+			case IniParserCore::EArrayOp::Add:
+				Table.FindOrAdd(Key, FString()).AddValue(MoveTemp(Value));
+				break;
+
+			case IniParserCore::EArrayOp::Remove:
+				if (FIniProperty* Property = Table.Find(Key))
+					Property->RemoveValue(Value);
+				break;
+		}
+	}
+
+	// Property of the current scope, without counting as a read for FIniReadTelemetry.
+	FORCEINLINE FIniProperty& FindOrAddArrayProperty(const FName& PropertyName)
+	{
+		return CurrentSection ? CurrentSection->FindOrAddProperty(PropertyName, FString()) : Data.FindOrAddProperty(PropertyName, FString());
+	}
+};
+
+/* Converts UTF-8 tokens to TCHAR one at a time and hands them to the regular builder */
+struct FIniUtf8DataBuilder
+{
+	typedef IniParserCore::TSpan<char> FSpan;
+	typedef IniParserCore::TSpan<TCHAR> FWideSpan;
+
+	FIniDataBuilder& Builder;
+
+	void OnComment(FSpan Text)
+	{
+		FUTF8ToTCHAR Converted(Text.Begin, static_cast<int32>(Text.Len()));
+		Builder.OnComment(FWideSpan{ Converted.Get(), Converted.Get() + Converted.Length() });
+	}
+
+	void OnSection(FSpan Name)
+	{
+		FUTF8ToTCHAR Converted(Name.Begin, static_cast<int32>(Name.Len()));
+		Builder.OnSection(FWideSpan{ Converted.Get(), Converted.Get() + Converted.Length() });
+	}
+
+	void OnProperty(FSpan Key, FSpan RawValue)
+	{
+		FUTF8ToTCHAR ConvertedKey(Key.Begin, static_cast<int32>(Key.Len()));
+		FUTF8ToTCHAR ConvertedValue(RawValue.Begin, static_cast<int32>(RawValue.Len()));
+
+		Builder.OnProperty(
+			FWideSpan{ ConvertedKey.Get(), ConvertedKey.Get() + ConvertedKey.Length() },
+			FWideSpan{ ConvertedValue.Get(), ConvertedValue.Get() + ConvertedValue.Length() });
+	}
+};
+
+/* Builds lazily loaded documents: global entries are parsed right away, section bodies are only located */
+struct FIniLazyIndexer
+{
+	/**
+	 * Index a document. Section bodies are parsed later, the first time FIniData looks them up.
+	 *
+	 * @param OUT Data Empty document to fill
+	 * @param IN Source Text to index; kept alive by the document until every section is parsed
+	 * @param IN KeyMode How keys are stored, now for global entries and later for every section
+	 * @param OUT OutNumEntries Comments, section headers and property lines in the source, parsed now or later
+	 * @return Number of lines in the source
+	 */
+	static int32 Index(FIniData& Data, FString&& Source, EIniKeyMode KeyMode, int32& OutNumEntries);
+};
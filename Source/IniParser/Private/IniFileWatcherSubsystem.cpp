@@ -0,0 +1,322 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniFileWatcherSubsystem.h"
+
+#include "IniParserModule.h"
+#include "IniLibrary.h"
+#include "IniPatch.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
+
+void UIniFileWatcherSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+#if WITH_EDITOR
+	bUseDirectoryWatcher = FModuleManager::Get().ModuleExists(TEXT("DirectoryWatcher"));
+#endif
+
+	if (!bUseDirectoryWatcher)
+		PollHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UIniFileWatcherSubsystem::Poll), POLL_INTERVAL);
+}
+
+void UIniFileWatcherSubsystem::Deinitialize()
+{
+	if (PollHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PollHandle);
+		PollHandle.Reset();
+	}
+
+	TArray<FString> Directories;
+	DirectoryHandles.GetKeys(Directories);
+
+	for (const FString& Directory : Directories)
+		UnwatchDirectory(Directory);
+
+	WatchedFiles.Empty();
+
+	Super::Deinitialize();
+}
+
+FIniData UIniFileWatcherSubsystem::WatchFile(const FString& FilePath)
+{
+	const FString FullPath = NormalizePath(FilePath);
+
+	if (const FWatchedFile* Existing = WatchedFiles.Find(FullPath))
+		return *Existing->Data;
+
+	FWatchedFile& Watched = WatchedFiles.Add(FullPath);
+	Watched.TimeStamp = IFileManager::Get().GetTimeStamp(*FullPath);
+	Watched.Data = MakeShared<FIniData>(UIniLibrary::ReadIniFromFile(FullPath));
+
+	if (bUseDirectoryWatcher)
+		WatchDirectory(FPaths::GetPath(FullPath));
+
+	return *Watched.Data;
+}
+
+void UIniFileWatcherSubsystem::UnwatchFile(const FString& FilePath)
+{
+	const FString FullPath = NormalizePath(FilePath);
+
+	if (WatchedFiles.Remove(FullPath) == 0)
+		return;
+
+	const FString Directory = FPaths::GetPath(FullPath);
+
+	for (const auto& WatchedPair : WatchedFiles)
+	{
+		if (FPaths::GetPath(WatchedPair.Key) == Directory)
+			return;
+	}
+
+	UnwatchDirectory(Directory);
+}
+
+bool UIniFileWatcherSubsystem::GetWatchedData(const FString& FilePath, FIniData& OutData) const
+{
+	const FWatchedFile* Watched = WatchedFiles.Find(NormalizePath(FilePath));
+
+	if (!Watched)
+		return false;
+
+	OutData = *Watched->Data;
+	return true;
+}
+
+FString UIniFileWatcherSubsystem::NormalizePath(const FString& FilePath)
+{
+	FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+	FPaths::NormalizeFilename(FullPath);
+	return FullPath;
+}
+
+bool UIniFileWatcherSubsystem::Poll(float DeltaTime)
+{
+	// A slow file system must not stall the game thread, so only the list of files is taken here.
+	if (bPollPending || WatchedFiles.IsEmpty())
+		return true;
+
+	TArray<TPair<FString, FDateTime>> Files;
+	Files.Reserve(WatchedFiles.Num());
+
+	for (const auto& WatchedPair : WatchedFiles)
+	{
+		if (!WatchedPair.Value.bReloadPending)
+			Files.Emplace(WatchedPair.Key, WatchedPair.Value.TimeStamp);
+	}
+
+	if (Files.IsEmpty())
+		return true;
+
+	bPollPending = true;
+
+	TWeakObjectPtr<UIniFileWatcherSubsystem> WeakThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Files = MoveTemp(Files)]()
+	{
+		TArray<FString> ChangedFiles;
+
+		for (const TPair<FString, FDateTime>& File : Files)
+		{
+			if (IFileManager::Get().GetTimeStamp(*File.Key) != File.Value)
+				ChangedFiles.Add(File.Key);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, ChangedFiles = MoveTemp(ChangedFiles)]()
+		{
+			if (UIniFileWatcherSubsystem* This = WeakThis.Get())
+				This->FinishPoll(ChangedFiles);
+		});
+	});
+
+	return true;
+}
+
+void UIniFileWatcherSubsystem::FinishPoll(const TArray<FString>& ChangedFiles)
+{
+	bPollPending = false;
+
+	// Files unwatched in the meantime are skipped by RequestReload.
+	for (const FString& FilePath : ChangedFiles)
+		RequestReload(FilePath);
+}
+
+void UIniFileWatcherSubsystem::OnDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+#if WITH_EDITOR
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (Change.Action == FFileChangeData::FCA_Removed)
+			continue;
+
+		const FString FullPath = NormalizePath(Change.Filename);
+
+		if (WatchedFiles.Contains(FullPath))
+			RequestReload(FullPath);
+	}
+#endif
+}
+
+void UIniFileWatcherSubsystem::WatchDirectory(const FString& Directory)
+{
+#if WITH_EDITOR
+	if (DirectoryHandles.Contains(Directory))
+		return;
+
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+
+	if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+	{
+		FDelegateHandle Handle;
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+			Directory,
+			IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &UIniFileWatcherSubsystem::OnDirectoryChanged),
+			Handle);
+
+		DirectoryHandles.Add(Directory, Handle);
+	}
+#endif
+}
+
+void UIniFileWatcherSubsystem::UnwatchDirectory(const FString& Directory)
+{
+#if WITH_EDITOR
+	FDelegateHandle Handle;
+
+	if (!DirectoryHandles.RemoveAndCopyValue(Directory, Handle))
+		return;
+
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Directory, Handle);
+	}
+#endif
+}
+
+void UIniFileWatcherSubsystem::RequestReload(const FString& FilePath)
+{
+	FWatchedFile* Watched = WatchedFiles.Find(FilePath);
+
+	if (!Watched)
+		return;
+
+	// The reload in flight may have read the file before this change, so read it again when it finishes.
+	if (Watched->bReloadPending)
+	{
+		Watched->bReloadAgain = true;
+		return;
+	}
+
+	Watched->bReloadPending = true;
+
+	TWeakObjectPtr<UIniFileWatcherSubsystem> WeakThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [WeakThis, FilePath]()
+	{
+		const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*FilePath);
+		FIniData NewData = UIniLibrary::ReadIniFromFile(FilePath);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, FilePath, TimeStamp, NewData = MoveTemp(NewData)]() mutable
+		{
+			if (UIniFileWatcherSubsystem* This = WeakThis.Get())
+				This->FinishReload(FilePath, MoveTemp(NewData), TimeStamp);
+		});
+	});
+}
+
+void UIniFileWatcherSubsystem::FinishReload(const FString& FilePath, FIniData&& NewData, const FDateTime& TimeStamp)
+{
+	FWatchedFile* Watched = WatchedFiles.Find(FilePath);
+
+	// Unwatched while the reload was in flight.
+	if (!Watched)
+		return;
+
+	const bool bReloadAgain = Watched->bReloadAgain;
+
+	Watched->bReloadPending = false;
+	Watched->bReloadAgain = false;
+	Watched->TimeStamp = TimeStamp;
+
+	// Listeners may unwatch the file and invalidate the entry, the shared references keep both versions alive.
+	const TSharedRef<const FIniData> OldData = Watched->Data;
+	const TSharedRef<const FIniData> CurrentData = MakeShared<FIniData>(MoveTemp(NewData));
+	Watched->Data = CurrentData;
+
+	UE_LOG(LogIniParser, Verbose, TEXT("Reloaded %s"), *FilePath);
+
+	BroadcastChanges(FilePath, *OldData, *CurrentData);
+
+	if (bReloadAgain)
+		RequestReload(FilePath);
+}
+
+void UIniFileWatcherSubsystem::BroadcastChanges(const FString& FilePath, const FIniData& OldData, const FIniData& NewData)
+{
+	const FIniPatch Patch = FIniPatch::Compute(OldData, NewData);
+
+	// Entries are grouped by section, so a section is reported once when the group ends.
+	bool bAnyChanged = false;
+	bool bSectionChanged = false;
+	FName PendingSection = NAME_None;
+
+	auto FlushSection = [&]()
+	{
+		if (bSectionChanged)
+			OnSectionChanged.Broadcast(FilePath, PendingSection);
+
+		bSectionChanged = false;
+	};
+
+	for (const FIniPatchEntry& Entry : Patch.GetEntries())
+	{
+		if (Entry.Section != PendingSection)
+		{
+			FlushSection();
+			PendingSection = Entry.Section;
+		}
+
+		switch (Entry.Operation)
+		{
+			case EIniPatchOperation::AddSection:
+				bSectionChanged = true;
+				break;
+
+			case EIniPatchOperation::RemoveSection:
+				if (const FIniSection* OldSection = OldData.GetSections().Find(Entry.Section))
+				{
+					for (const auto& PropertyPair : OldSection->GetProperties())
+						OnPropertyChanged.Broadcast(FilePath, Entry.Section, PropertyPair.Key);
+				}
+
+				bSectionChanged = true;
+				break;
+
+			case EIniPatchOperation::SetProperty:
+			case EIniPatchOperation::RemoveProperty:
+				OnPropertyChanged.Broadcast(FilePath, Entry.Section, Entry.Key);
+				bSectionChanged = true;
+				break;
+
+			default:
+				break;
+		}
+
+		bAnyChanged |= bSectionChanged;
+	}
+
+	FlushSection();
+
+	if (bAnyChanged)
+		OnFileReloaded.Broadcast(FilePath, NewData);
+}
\ No newline at end of file
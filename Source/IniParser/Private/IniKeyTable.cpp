@@ -0,0 +1,106 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniKeyTable.h"
+
+#include "Hash/CityHash.h"
+
+uint64 FIniKeyTable::HashKey(FStringView Key)
+{
+	return CityHash64(reinterpret_cast<const char*>(Key.GetData()), static_cast<uint32>(Key.Len() * sizeof(TCHAR)));
+}
+
+void FIniKeyTable::Reserve(int32 NumEntries)
+{
+	Entries.Reserve(NumEntries);
+	Index.Reserve(NumEntries);
+}
+
+int32 FIniKeyTable::FindIndex(FStringView Key, uint64 Hash) const
+{
+	const int32* First = Index.Find(Hash);
+
+	for (int32 EntryIndex = First ? *First : INDEX_NONE; EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].NextWithSameHash)
+	{
+		if (Key.Equals(Entries[EntryIndex].Key, ESearchCase::CaseSensitive))
+			return EntryIndex;
+	}
+
+	return INDEX_NONE;
+}
+
+FIniProperty* FIniKeyTable::Find(FStringView Key, uint64 Hash)
+{
+	const int32 EntryIndex = FindIndex(Key, Hash);
+
+	return EntryIndex != INDEX_NONE ? &Entries[EntryIndex].Property : nullptr;
+}
+
+const FIniProperty* FIniKeyTable::Find(FStringView Key, uint64 Hash) const
+{
+	const int32 EntryIndex = FindIndex(Key, Hash);
+
+	return EntryIndex != INDEX_NONE ? &Entries[EntryIndex].Property : nullptr;
+}
+
+FIniProperty& FIniKeyTable::FindOrAdd(FStringView Key, FString&& Value)
+{
+	const uint64 Hash = HashKey(Key);
+	const int32 Found = FindIndex(Key, Hash);
+
+	if (Found != INDEX_NONE)
+		return Entries[Found].Property;
+
+	const int32 EntryIndex = Entries.AddDefaulted();
+
+	FIniKeyedProperty& Entry = Entries[EntryIndex];
+	Entry.Key = FString(Key);
+	Entry.Hash = Hash;
+	Entry.Property = FIniProperty(MoveTemp(Value));
+
+	// Chain behind an existing entry with the same hash; that only happens on a real 64-bit collision.
+	int32& First = Index.FindOrAdd(Hash, INDEX_NONE);
+	Entry.NextWithSameHash = First;
+	First = EntryIndex;
+
+	return Entry.Property;
+}
+
+int32& FIniKeyTable::FindLink(uint64 Hash, int32 EntryIndex)
+{
+	int32* Link = &Index.FindChecked(Hash);
+
+	while (*Link != EntryIndex)
+		Link = &Entries[*Link].NextWithSameHash;
+
+	return *Link;
+}
+
+bool FIniKeyTable::Remove(FStringView Key)
+{
+	const uint64 Hash = HashKey(Key);
+	const int32 EntryIndex = FindIndex(Key, Hash);
+
+	if (EntryIndex == INDEX_NONE)
+		return false;
+
+	FindLink(Hash, EntryIndex) = Entries[EntryIndex].NextWithSameHash;
+
+	if (Index.FindChecked(Hash) == INDEX_NONE)
+		Index.Remove(Hash);
+
+	// The last entry fills the gap; only the one link that pointed at it changes.
+	const int32 LastIndex = Entries.Num() - 1;
+
+	if (EntryIndex != LastIndex)
+		FindLink(Entries[LastIndex].Hash, LastIndex) = EntryIndex;
+
+	Entries.RemoveAtSwap(EntryIndex, 1, false);
+
+	return true;
+}
+
+void FIniKeyTable::Reset()
+{
+	Entries.Reset();
+	Index.Reset();
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniLayerStack.h"
+#include "IniPatch.h"
+
+template <typename FuncType>
+void FIniLayerStack::ForEachKey(const FIniData& Layer, FuncType&& Func)
+{
+	for (const auto& PropertyPair : Layer.GetProperties())
+		Func(FKey{ NAME_None, PropertyPair.Key });
+
+	for (const auto& SectionPair : Layer.GetSections())
+	{
+		for (const auto& PropertyPair : SectionPair.Value.GetProperties())
+			Func(FKey{ SectionPair.Key, PropertyPair.Key });
+	}
+}
+
+int32 FIniLayerStack::AddLayer(FIniData Data)
+{
+	if (!ensureMsgf(!Data.HasKeyedProperties(), TEXT("FIniLayerStack does not support case-sensitive keys, the layer is not added")))
+		return INDEX_NONE;
+
+	const int32 LayerIndex = Layers.Add(MoveTemp(Data));
+
+	// The new layer is on top, so every key it defines now resolves to it.
+	ForEachKey(Layers[LayerIndex], [this, LayerIndex](const FKey& Key)
+	{
+		Index.Add(Key, LayerIndex);
+	});
+
+	return LayerIndex;
+}
+
+void FIniLayerStack::SetLayer(int32 LayerIndex, FIniData Data)
+{
+	check(Layers.IsValidIndex(LayerIndex));
+
+	if (!ensureMsgf(!Data.HasKeyedProperties(), TEXT("FIniLayerStack does not support case-sensitive keys, the layer is not replaced")))
+		return;
+
+	const FIniPatch Patch = FIniPatch::Compute(Layers[LayerIndex], Data);
+	const FIniData Previous = MoveTemp(Layers[LayerIndex]);
+	Layers[LayerIndex] = MoveTemp(Data);
+
+	for (const FIniPatchEntry& Entry : Patch.GetEntries())
+	{
+		switch (Entry.Operation)
+		{
+			case EIniPatchOperation::SetProperty:
+			case EIniPatchOperation::RemoveProperty:
+				Resolve({ Entry.Section, Entry.Key });
+				break;
+
+			case EIniPatchOperation::RemoveSection:
+				if (const FIniSection* Section = Previous.GetSections().Find(Entry.Section))
+				{
+					for (const auto& PropertyPair : Section->GetProperties())
+						Resolve({ Entry.Section, PropertyPair.Key });
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+const FIniData& FIniLayerStack::GetLayer(int32 LayerIndex) const
+{
+	return Layers[LayerIndex];
+}
+
+const FIniProperty* FIniLayerStack::FindProperty(const FName& SectionName, const FName& PropertyName) const
+{
+	const FKey Key{ SectionName, PropertyName };
+	const int32* LayerIndex = Index.Find(Key);
+
+	return LayerIndex ? FindInLayer(Layers[*LayerIndex], Key) : nullptr;
+}
+
+int32 FIniLayerStack::FindLayerOfProperty(const FName& SectionName, const FName& PropertyName) const
+{
+	const int32* LayerIndex = Index.Find({ SectionName, PropertyName });
+	return LayerIndex ? *LayerIndex : INDEX_NONE;
+}
+
+FIniData FIniLayerStack::Flatten() const
+{
+	FIniData Merged;
+
+	for (const auto& IndexPair : Index)
+	{
+		const FIniProperty* Property = FindInLayer(Layers[IndexPair.Value], IndexPair.Key);
+
+		if (IndexPair.Key.Section.IsNone())
+			Merged.FindOrAddProperty(IndexPair.Key.Property, FString()) = *Property;
+		else
+			Merged.FindOrAddSection(IndexPair.Key.Section).FindOrAddProperty(IndexPair.Key.Property, FString()) = *Property;
+	}
+
+	return Merged;
+}
+
+const FIniProperty* FIniLayerStack::FindInLayer(const FIniData& Layer, const FKey& Key)
+{
+	if (Key.Section.IsNone())
+		return Layer.GetProperties().Find(Key.Property);
+
+	const FIniSection* Section = Layer.GetSections().Find(Key.Section);
+	return Section ? Section->GetProperties().Find(Key.Property) : nullptr;
+}
+
+void FIniLayerStack::Resolve(const FKey& Key)
+{
+	for (int32 LayerIndex = Layers.Num() - 1; LayerIndex >= 0; --LayerIndex)
+	{
+		if (FindInLayer(Layers[LayerIndex], Key))
+		{
+			Index.Add(Key, LayerIndex);
+			return;
+		}
+	}
+
+	Index.Remove(Key);
+}
\ No newline at end of file
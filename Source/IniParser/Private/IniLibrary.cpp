@@ -3,271 +3,307 @@
 #include "IniLibrary.h"
 
 #include "IniParserModule.h"
+#include "IniDataBuilder.h"
+#include "IniPack.h"
+#include "IniParserStats.h"
+#include "IniReadTelemetry.h"
 
 #include "Kismet/KismetStringLibrary.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "GenericPlatform/GenericPlatformFile.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
-static const char& COMMENT_CHAR = ';';
-static const char& SECTION_START_CHAR = '[';
-static const char& SECTION_END_CHAR = ']';
-static const char& DOUBLE_QUOTE_CHAR = '\"';
-static const char& APOSTROPHE_CHAR = '\'';
-static const char& TAB_CHAR = '\t';
-static const char& NEWLINE_CHAR = '\n';
-static const char& SPACE_CHAR = ' ';
-static const char& EMPTY_CHAR = '\0';
-static const char& EQUALS_CHAR = '=';
+#include "IniParserCore/IniDiagnostics.h"
+#include "IniParserCore/IniTokenizer.h"
+#include "IniParserCore/IniWriter.h"
 
-void UIniLibrary::AppendBuffer(char* Buffer, char Char)
+CSV_DEFINE_CATEGORY(IniParser, true);
+
+TRACE_DECLARE_INT_COUNTER(IniParserBytesRead, TEXT("IniParser/BytesRead"));
+TRACE_DECLARE_INT_COUNTER(IniParserBytesWritten, TEXT("IniParser/BytesWritten"));
+TRACE_DECLARE_INT_COUNTER(IniParserLinesRead, TEXT("IniParser/LinesRead"));
+TRACE_DECLARE_INT_COUNTER(IniParserEntriesRead, TEXT("IniParser/EntriesRead"));
+
+/* Regular builder plus error reporting. Only the diagnostics variants use it, so the normal parse path has no error checks at all. */
+struct FIniDiagnosticsBuilder
 {
-	if (iscntrl(Char)) // Check if character is a control character
-		return;
+	typedef IniParserCore::TSpan<TCHAR> FSpan;
 
-	char str[2] = { Char, EMPTY_CHAR };
-	strcat_s(Buffer, 256, str);
-}
+	FIniDataBuilder& Builder;
+	TArray<FIniDiagnostic>& Diagnostics;
+	IniParserCore::TLineLocator<TCHAR> Locator;
+
+	void OnComment(FSpan Text)
+	{
+		Builder.OnComment(Text);
+	}
+
+	void OnSection(FSpan Name)
+	{
+		Builder.OnSection(Name);
+	}
+
+	void OnProperty(FSpan Key, FSpan RawValue)
+	{
+		FSpan Name = Key;
+		const bool bArrayOp = IniParserCore::SplitArrayOp(Name) != IniParserCore::EArrayOp::None;
+
+		// Array operations are expected to repeat their key.
+		if (!bArrayOp && IsDuplicate(Name))
+			Report(EIniDiagnosticSeverity::Warning, Key.Begin, FString::Printf(TEXT("Duplicate key '%s', the first value is kept"), *FString(static_cast<int32>(Name.Len()), Name.Begin)));
+
+		Builder.OnProperty(Key, RawValue);
+	}
+
+	/* Whether the current scope already has the key, compared the way the document stores keys */
+	bool IsDuplicate(FSpan Name)
+	{
+		if (Builder.Data.GetKeyMode() == EIniKeyMode::CaseSensitive)
+		{
+			FIniKeyTable& Table = Builder.CurrentSection ? Builder.CurrentSection->GetKeyedProperties() : Builder.Data.GetKeyedProperties();
+			return Table.Find(FStringView(Name.Begin, static_cast<int32>(Name.Len()))) != nullptr;
+		}
+
+		const FName PropertyName(static_cast<int32>(Name.Len()), Name.Begin);
+
+		return Builder.CurrentSection
+			? Builder.CurrentSection->HasProperty(PropertyName)
+			: Builder.Data.GetProperties().Contains(PropertyName);
+	}
 
-void UIniLibrary::TrimBuffer(char* Buffer)
+	void OnError(IniParserCore::ELineError Error, const TCHAR* At)
+	{
+		Report(IniParserCore::IsWarning(Error) ? EIniDiagnosticSeverity::Warning : EIniDiagnosticSeverity::Error, At, FString(IniParserCore::GetErrorMessage(Error)));
+	}
+
+	void Report(EIniDiagnosticSeverity Severity, const TCHAR* At, FString Message)
+	{
+		int Line, Column;
+		Locator.Locate(At, Line, Column);
+
+		Diagnostics.Emplace(Severity, Line, Column, MoveTemp(Message));
+	}
+};
+
+/* Lets IniParserCore writers append to an FStringBuilder */
+struct FIniBuilderSink
 {
-	char* Char = &Buffer[strlen(Buffer) - 1];
+	FStringBuilderBase& Builder;
 
-	if (*Char == SPACE_CHAR || *Char == TAB_CHAR)
+	FORCEINLINE void Write(const TCHAR* Chars, size_t Len)
 	{
-		*Char = EMPTY_CHAR;
-		TrimBuffer(Buffer);
+		Builder.Append(Chars, static_cast<int32>(Len));
 	}
+};
+
+static FORCEINLINE IniParserCore::TSpan<TCHAR> ToSpan(const FString& String)
+{
+	return { *String, *String + String.Len() };
+}
+
+/* Parse a document and report how much work it took */
+static FIniData ParseIni(const FString& String, EIniKeyMode KeyMode, int32& OutNumLines, int32& OutNumEntries)
+{
+	FIniData GlobalData;
+	GlobalData.SetKeyMode(KeyMode);
+
+	TArray<FIniEntryCounts> EntryCounts;
+	OutNumLines = CountEntries(String, EntryCounts);
+
+	GlobalData.Reserve(EntryCounts.Num() - 1, EntryCounts[0].NumProperties, EntryCounts[0].NumComments);
+
+	FIniDataBuilder Builder{ GlobalData, EntryCounts };
+	IniParserCore::Tokenize(*String, *String + String.Len(), Builder);
+
+	OutNumEntries = Builder.NumEntries;
+
+	const int64 NumBytes = String.Len() * sizeof(TCHAR);
+
+	TRACE_COUNTER_ADD(IniParserBytesRead, NumBytes);
+	TRACE_COUNTER_ADD(IniParserLinesRead, OutNumLines);
+	TRACE_COUNTER_ADD(IniParserEntriesRead, OutNumEntries);
+
+	CSV_CUSTOM_STAT(IniParser, BytesRead, static_cast<int32>(NumBytes), ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(IniParser, LinesRead, OutNumLines, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(IniParser, EntriesRead, OutNumEntries, ECsvCustomStatOp::Accumulate);
+
+	return GlobalData;
 }
 
 FIniData UIniLibrary::ParseIniFromString(FString String)
 {
+	return ParseIniFromStringWithKeyMode(MoveTemp(String), EIniKeyMode::Name);
+}
+
+FIniData UIniLibrary::ParseIniFromStringWithKeyMode(FString String, EIniKeyMode KeyMode)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::ParseIniFromString);
+	CSV_SCOPED_TIMING_STAT(IniParser, ParseIniFromString);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	int32 NumLines, NumEntries;
+	FIniData Data = ParseIni(String, KeyMode, NumLines, NumEntries);
+
+	if (FIniParserStats::IsEnabled())
+		FIniParserStats::RecordRead(FIniParserStats::STRING_SOURCE, String.Len() * sizeof(TCHAR), NumLines, NumEntries, FPlatformTime::Seconds() - StartTime);
+
+	return Data;
+}
+
+FIniData UIniLibrary::ParseIniFromStringLazy(FString String, EIniKeyMode KeyMode)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::ParseIniFromStringLazy);
+	CSV_SCOPED_TIMING_STAT(IniParser, ParseIniFromStringLazy);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int64 NumBytes = String.Len() * sizeof(TCHAR);
+
+	FIniData Data;
+	int32 NumEntries;
+	const int32 NumLines = FIniLazyIndexer::Index(Data, MoveTemp(String), KeyMode, NumEntries);
+
+	if (FIniParserStats::IsEnabled())
+		FIniParserStats::RecordRead(FIniParserStats::STRING_SOURCE, NumBytes, NumLines, NumEntries, FPlatformTime::Seconds() - StartTime);
+
+	return Data;
+}
+
+FIniData UIniLibrary::ParseIniFromStringWithDiagnostics(FString String, TArray<FIniDiagnostic>& OutDiagnostics, EIniKeyMode KeyMode)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::ParseIniFromStringWithDiagnostics);
+
 	FIniData GlobalData;
+	GlobalData.SetKeyMode(KeyMode);
 
-	char Buffer[256] = { EMPTY_CHAR };
-	char CurrentSection[256] = { EMPTY_CHAR };
-	char CurrentKey[256];
-	char CurrentValue[256];
-	char CurrentComment[256];
+	TArray<FIniEntryCounts> EntryCounts;
+	CountEntries(String, EntryCounts);
 
-	enum class ParserState
-	{
-		ReadyForIniData,
-		CommentStarted,
-		SectionNameStarted,
-		KeyStarted,
-		KeyFinished,
-		ReadyForValue,
-		ValueStarted,
-		InvalidKeyFormat
-	};
-
-	ParserState State = ParserState::ReadyForIniData;
-
-	for (TCHAR Char : String)
+	GlobalData.Reserve(EntryCounts.Num() - 1, EntryCounts[0].NumProperties, EntryCounts[0].NumComments);
+
+	FIniDataBuilder Builder{ GlobalData, EntryCounts };
+	FIniDiagnosticsBuilder DiagnosticsBuilder{ Builder, OutDiagnostics, IniParserCore::TLineLocator<TCHAR>(*String) };
+
+	OutDiagnostics.Reset();
+	IniParserCore::Tokenize(*String, *String + String.Len(), DiagnosticsBuilder);
+
+	return GlobalData;
+}
+
+FIniData UIniLibrary::ReadIniFromFileWithDiagnostics(FString FilePath, TArray<FIniDiagnostic>& OutDiagnostics, EIniKeyMode KeyMode)
+{
+	FString Contents;
+	OutDiagnostics.Reset();
+
+	if (!FFileHelper::LoadFileToString(Contents, *FilePath, FFileHelper::EHashOptions::None))
 	{
-		switch (State)
-		{
-			case ParserState::ReadyForIniData:
-				switch (Char)
-				{
-					case COMMENT_CHAR:
-						State = ParserState::CommentStarted;
-						continue;
-
-					case SECTION_START_CHAR:
-						State = ParserState::SectionNameStarted;
-						break;
-
-					case SPACE_CHAR:
-					case NEWLINE_CHAR:
-					case TAB_CHAR:
-						break;
-
-					default:
-						AppendBuffer(Buffer, Char);
-						State = ParserState::KeyStarted;
-						break;
-				}
-				break;
-
-			case ParserState::CommentStarted:
-				if (Char == NEWLINE_CHAR)
-				{
-					TrimBuffer(Buffer);
-					strcpy_s(CurrentComment, Buffer);
-					Buffer[0] = EMPTY_CHAR;
-
-					State = ParserState::ReadyForIniData;
-
-					if (CurrentSection[0] == EMPTY_CHAR)
-						GlobalData.AddComment(CurrentComment);
-					else
-					{
-						FIniSection& Section = GlobalData.FindOrAddSection(FName(CurrentSection));
-						Section.AddComment(CurrentComment);
-					}
-				}
-				else
-					AppendBuffer(Buffer, Char);
-				break;
-
-			case ParserState::SectionNameStarted:
-				switch (Char)
-				{
-					case SECTION_END_CHAR:
-						strcpy_s(CurrentSection, Buffer);
-						Buffer[0] = EMPTY_CHAR;
-						State = ParserState::ReadyForIniData;
-						break;
-
-					case NEWLINE_CHAR:
-						Buffer[0] = EMPTY_CHAR;
-						State = ParserState::ReadyForIniData;
-						break;
-
-					default:
-						AppendBuffer(Buffer, Char);
-						break;
-				}
-				break;
-
-			case ParserState::KeyStarted:
-				switch (Char)
-				{
-					case SPACE_CHAR:
-					case TAB_CHAR:
-						strcpy_s(CurrentKey, Buffer);
-						Buffer[0] = EMPTY_CHAR;
-						State = ParserState::KeyFinished;
-						break;
-
-					case NEWLINE_CHAR:
-						State = ParserState::ReadyForIniData;
-						break;
-
-					default:
-						AppendBuffer(Buffer, Char);
-						break;
-				}
-				break;
-
-			case ParserState::KeyFinished:
-				switch (Char)
-				{
-					case EQUALS_CHAR:
-						State = ParserState::ReadyForValue;
-						break;
-
-					case NEWLINE_CHAR:
-						State = ParserState::ReadyForIniData;
-						break;
-
-					case SPACE_CHAR:
-					case TAB_CHAR:
-						break;
-
-					default:
-						State = ParserState::InvalidKeyFormat;
-						break;
-				}
-				break;
-
-			case ParserState::ReadyForValue:
-				switch (Char)
-				{
-					case NEWLINE_CHAR:
-						State = ParserState::ReadyForIniData;
-						break;
-
-					case SPACE_CHAR:
-					case TAB_CHAR:
-						break;
-
-					default:
-						if (Char != DOUBLE_QUOTE_CHAR && Char != APOSTROPHE_CHAR)
-							AppendBuffer(Buffer, Char);
-
-						State = ParserState::ValueStarted;
-						break;
-				}
-				break;
-
-			case ParserState::ValueStarted:
-				switch (Char)
-				{
-					case NEWLINE_CHAR:
-					{
-						TrimBuffer(Buffer);
-						strcpy_s(CurrentValue, Buffer);
-						Buffer[0] = EMPTY_CHAR;
-						State = ParserState::ReadyForIniData;
-
-						if (CurrentSection[0] == EMPTY_CHAR)
-							GlobalData.FindOrAddProperty(FName(CurrentKey), CurrentValue);
-						else
-						{
-							FIniSection& Section = GlobalData.FindOrAddSection(FName(CurrentSection));
-							Section.FindOrAddProperty(FName(CurrentKey), CurrentValue);
-						}
-					}
-					break;
-
-					case DOUBLE_QUOTE_CHAR:
-					case APOSTROPHE_CHAR:
-						break;
-
-					default:
-						AppendBuffer(Buffer, Char);
-						break;
-				}
-				break;
-
-			case ParserState::InvalidKeyFormat:
-				if (Char == NEWLINE_CHAR)
-					State = ParserState::ReadyForIniData;
-				break;
-			}
+		OutDiagnostics.Emplace(EIniDiagnosticSeverity::Error, 0, 0, FString::Printf(TEXT("Can not read %s"), *FilePath));
+		return FIniData();
 	}
 
-	if (State == ParserState::ValueStarted)
+	return ParseIniFromStringWithDiagnostics(MoveTemp(Contents), OutDiagnostics, KeyMode);
+}
+
+bool UIniLibrary::ValidateIni(const FIniData& Data, const FIniData& Schema, TArray<FIniSchemaViolation>& OutViolations)
+{
+	OutViolations.Reset();
+
+	TArray<FString> SchemaErrors;
+	const FIniSchema CompiledSchema = FIniSchema::Compile(Schema, SchemaErrors);
+
+	for (FString& Error : SchemaErrors)
+		OutViolations.Emplace(NAME_None, NAME_None, FString::Printf(TEXT("Schema: %s"), *Error));
+
+	return CompiledSchema.Validate(Data, OutViolations) && SchemaErrors.IsEmpty();
+}
+
+static FORCEINLINE void AppendKey(FStringBuilderBase& Builder, const FName& Key)
+{
+	Key.AppendString(Builder);
+}
+
+static FORCEINLINE void AppendKey(FStringBuilderBase& Builder, const FString& Key)
+{
+	Builder.Append(Key);
+}
+
+/* False, with an error logged, if a value of the property would read back differently (see IniParserCore::IsWritable); such properties are not written */
+template <typename KeyT>
+static bool CanWriteProperty(const KeyT& Key, const FIniProperty& Property)
+{
+	bool bWritable = IniParserCore::IsWritable(ToSpan(Property.GetValue()));
+
+	for (const FString& Element : Property.GetValues())
+		bWritable &= IniParserCore::IsWritable(ToSpan(Element));
+
+	if (!bWritable)
 	{
-		TrimBuffer(Buffer);
-		strcpy_s(CurrentValue, Buffer);
-		Buffer[0] = EMPTY_CHAR;
-		State = ParserState::ReadyForIniData;
+		TStringBuilder<64> Name;
+		AppendKey(Name, Key);
 
-		FIniSection& Section = GlobalData.FindOrAddSection(FName(CurrentSection));
-		Section.AddProperty(FName(CurrentKey), CurrentValue);
+		UE_LOG(LogIniParser, Error, TEXT("ERROR: Can not write %s, a line of its multi-line value would be read as the end of the value or as another entry"), Name.ToString());
 	}
 
-	return GlobalData;
+	return bWritable;
 }
 
-FString UIniLibrary::ParseIniToString(const FIniData& Data)
+/* "Key = Value", or one "+Key = Element" line per array element, without the final newline */
+template <typename KeyT>
+static void WriteProperty(FStringBuilderBase& Builder, const KeyT& Key, const FIniProperty& Property)
+{
+	FIniBuilderSink Sink{ Builder };
+
+	if (!Property.IsArray())
+	{
+		AppendKey(Builder, Key);
+		IniParserCore::WriteAssignment(Sink, ToSpan(Property.GetValue()));
+		return;
+	}
+
+	for (int32 Index = 0; Index < Property.GetValues().Num(); Index++)
+	{
+		if (Index > 0)
+			Builder.AppendChar(NEWLINE_CHAR);
+
+		Builder.AppendChar(TEXT('+'));
+		AppendKey(Builder, Key);
+		IniParserCore::WriteAssignment(Sink, ToSpan(Property.GetValues()[Index]));
+	}
+}
+
+/* Serialize a document and report how many lines it produced */
+static FString WriteIni(const FIniData& Data, int32& OutNumLines)
 {
-	FStringBuilderBase Builder;
+	TStringBuilder<1024> Builder;
+	FIniBuilderSink Sink{ Builder };
 
 	// Global comments
 	for (const auto& Comment : Data.GetComments())
 	{
-		Builder.AppendChar(COMMENT_CHAR);
-		Builder.AppendChar(SPACE_CHAR);
-		Builder.Append(Comment);
+		IniParserCore::WriteComment(Sink, ToSpan(Comment));
 		Builder.AppendChar(NEWLINE_CHAR);
 	}
 
 	// Global properties
 	for (const auto& PropertyPair : Data.GetProperties())
 	{
-		const FIniProperty& Property = PropertyPair.Value;
+		if (!CanWriteProperty(PropertyPair.Key, PropertyPair.Value))
+			continue;
 
-		Builder.Append(PropertyPair.Key.ToString());
-		Builder.AppendChar(SPACE_CHAR);
-		Builder.AppendChar(EQUALS_CHAR);
-		Builder.AppendChar(SPACE_CHAR);
-		Builder.Append(Property.GetValueReadableString());
+		WriteProperty(Builder, PropertyPair.Key, PropertyPair.Value);
+		Builder.AppendChar(NEWLINE_CHAR);
+	}
+
+	for (const FIniKeyedProperty& Entry : Data.GetKeyedProperties().GetEntries())
+	{
+		if (!CanWriteProperty(Entry.Key, Entry.Property))
+			continue;
+
+		WriteProperty(Builder, Entry.Key, Entry.Property);
 		Builder.AppendChar(NEWLINE_CHAR);
 	}
 
@@ -280,35 +316,43 @@ FString UIniLibrary::ParseIniToString(const FIniData& Data)
 	{
 		const FIniSection& Section = SectionPair.Value;
 
+		// Names are appended straight from the name table, without a temporary FString.
 		Builder.AppendChar(SECTION_START_CHAR);
-		Builder.Append(SectionPair.Key.ToString());
-		Builder.AppendChar(SECTION_END_CHAR);
+		SectionPair.Key.AppendString(Builder);
+		Builder.AppendChar(TEXT(']'));
 		Builder.AppendChar(NEWLINE_CHAR);
 
 		for (const auto& Comment : Section.GetComments())
 		{
-			Builder.AppendChar(COMMENT_CHAR);
-			Builder.AppendChar(SPACE_CHAR);
-			Builder.Append(Comment);
+			IniParserCore::WriteComment(Sink, ToSpan(Comment));
 			Builder.AppendChar(NEWLINE_CHAR);
 		}
 
-		int32 NumOfProperties = Section.GetNumOfProperties();
+		// Properties are separated by newlines; the last one is followed by the blank line between sections.
+		bool bFirstProperty = true;
 
 		for (const auto& PropertyPair : Section.GetProperties())
 		{
-			const FIniProperty& Property = PropertyPair.Value;
+			if (!CanWriteProperty(PropertyPair.Key, PropertyPair.Value))
+				continue;
 
-			Builder.Append(PropertyPair.Key.ToString());
-			Builder.AppendChar(SPACE_CHAR);
-			Builder.AppendChar(EQUALS_CHAR);
-			Builder.AppendChar(SPACE_CHAR);
-			Builder.Append(Property.GetValueReadableString());
+			if (!bFirstProperty)
+				Builder.AppendChar(NEWLINE_CHAR);
 
-			NumOfProperties--;
+			WriteProperty(Builder, PropertyPair.Key, PropertyPair.Value);
+			bFirstProperty = false;
+		}
 
-			if (NumOfProperties >= 1)
+		for (const FIniKeyedProperty& Entry : Section.GetKeyedProperties().GetEntries())
+		{
+			if (!CanWriteProperty(Entry.Key, Entry.Property))
+				continue;
+
+			if (!bFirstProperty)
 				Builder.AppendChar(NEWLINE_CHAR);
+
+			WriteProperty(Builder, Entry.Key, Entry.Property);
+			bFirstProperty = false;
 		}
 
 		NumOfSections--;
@@ -320,18 +364,63 @@ FString UIniLibrary::ParseIniToString(const FIniData& Data)
 		}
 	}
 
+	OutNumLines = 0;
+
+	for (TCHAR Char : Builder.ToView())
+		OutNumLines += Char == NEWLINE_CHAR;
+
+	OutNumLines += Builder.Len() > 0;
+
+	TRACE_COUNTER_ADD(IniParserBytesWritten, Builder.Len() * sizeof(TCHAR));
+	CSV_CUSTOM_STAT(IniParser, BytesWritten, static_cast<int32>(Builder.Len() * sizeof(TCHAR)), ECsvCustomStatOp::Accumulate);
+
 	return Builder.ToString();
 }
 
+FString UIniLibrary::ParseIniToString(const FIniData& Data)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::ParseIniToString);
+	CSV_SCOPED_TIMING_STAT(IniParser, ParseIniToString);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	int32 NumLines;
+	FString String = WriteIni(Data, NumLines);
+
+	if (FIniParserStats::IsEnabled())
+		FIniParserStats::RecordWrite(FIniParserStats::STRING_SOURCE, String.Len() * sizeof(TCHAR), NumLines, FPlatformTime::Seconds() - StartTime);
+
+	return String;
+}
+
 FIniData UIniLibrary::ReadIniFromFile(FString FilePath)
 {
+	return ReadIniFromFileWithKeyMode(MoveTemp(FilePath), EIniKeyMode::Name);
+}
+
+FIniData UIniLibrary::ReadIniFromFileWithKeyMode(FString FilePath, EIniKeyMode KeyMode)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::ReadIniFromFile);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FilePath);
+	CSV_SCOPED_TIMING_STAT(IniParser, ReadIniFromFile);
+
 	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
 	FString Contents;
 
 	if (FileManager.FileExists(*FilePath))
 	{
+		const double StartTime = FPlatformTime::Seconds();
+
 		if (FFileHelper::LoadFileToString(Contents, *FilePath, FFileHelper::EHashOptions::None))
-			return ParseIniFromString(Contents);
+		{
+			int32 NumLines, NumEntries;
+			FIniData Data = ParseIni(Contents, KeyMode, NumLines, NumEntries);
+
+			if (FIniParserStats::IsEnabled())
+				FIniParserStats::RecordRead(FilePath, FileManager.FileSize(*FilePath), NumLines, NumEntries, FPlatformTime::Seconds() - StartTime);
+
+			return Data;
+		}
 	}
 	else
 	{
@@ -342,27 +431,92 @@ FIniData UIniLibrary::ReadIniFromFile(FString FilePath)
 	return FIniData();
 }
 
-void UIniLibrary::WriteIniToFile(FString FilePath, const FIniData& Data)
+FIniData UIniLibrary::ReadIniFromFileLazy(FString FilePath, EIniKeyMode KeyMode)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::ReadIniFromFileLazy);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FilePath);
+	CSV_SCOPED_TIMING_STAT(IniParser, ReadIniFromFileLazy);
+
 	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
 	FString Contents;
 
+	if (FileManager.FileExists(*FilePath))
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		if (FFileHelper::LoadFileToString(Contents, *FilePath, FFileHelper::EHashOptions::None))
+		{
+			FIniData Data;
+			int32 NumEntries;
+			const int32 NumLines = FIniLazyIndexer::Index(Data, MoveTemp(Contents), KeyMode, NumEntries);
+
+			if (FIniParserStats::IsEnabled())
+				FIniParserStats::RecordRead(FilePath, FileManager.FileSize(*FilePath), NumLines, NumEntries, FPlatformTime::Seconds() - StartTime);
+
+			return Data;
+		}
+	}
+	else
+	{
+		UE_LOG(LogIniParser, Warning, TEXT("ERROR: Can not read the file because it was not found."));
+		UE_LOG(LogIniParser, Warning, TEXT("Expected file location: %s"), *FilePath);
+	}
+
+	return FIniData();
+}
+
+void UIniLibrary::WriteIniToFile(FString FilePath, const FIniData& Data)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UIniLibrary::WriteIniToFile);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FilePath);
+	CSV_SCOPED_TIMING_STAT(IniParser, WriteIniToFile);
+
+	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
 	FString Directory = FPaths::GetPath(FilePath);
 
 	if (!FPaths::DirectoryExists(*Directory))
 		FileManager.CreateDirectoryTree(*Directory);
 
-	FFileHelper::SaveStringToFile(ParseIniToString(Data), *FilePath);
+	const double StartTime = FPlatformTime::Seconds();
+
+	int32 NumLines;
+	FString Contents = WriteIni(Data, NumLines);
+
+	if (FFileHelper::SaveStringToFile(Contents, *FilePath) && FIniParserStats::IsEnabled())
+		FIniParserStats::RecordWrite(FilePath, FileManager.FileSize(*FilePath), NumLines, FPlatformTime::Seconds() - StartTime);
+}
+
+FIniData UIniLibrary::ReadIniFromCompressedFile(FString FilePath)
+{
+	CSV_SCOPED_TIMING_STAT(IniParser, ReadIniFromCompressedFile);
+
+	FIniData Data;
+	FIniCompression::ReadFromFile(FilePath, Data);
+
+	return Data;
+}
+
+void UIniLibrary::WriteIniToCompressedFile(FString FilePath, const FIniData& Data, EIniCompressionFormat Format)
+{
+	CSV_SCOPED_TIMING_STAT(IniParser, WriteIniToCompressedFile);
+
+	FIniCompression::WriteToFile(FilePath, Data, Format);
+}
+
+bool UIniLibrary::BuildIniPack(FString Directory, FString OutputPath)
+{
+	return FIniPack::Build(Directory, OutputPath);
 }
 
 FIniData UIniLibrary::MakeIniData(TMap<FName, FIniSection> Sections)
 {
-	return FIniData(Sections);
+	return FIniData(MoveTemp(Sections));
 }
 
 FIniSection UIniLibrary::MakeIniSection(TMap<FName, FIniProperty> Properties)
 {
-	return FIniSection(Properties);
+	return FIniSection(MoveTemp(Properties));
 }
 
 FString UIniLibrary::Conv_IniDataToString(const FIniData& Data)
@@ -370,6 +524,16 @@ FString UIniLibrary::Conv_IniDataToString(const FIniData& Data)
 	return ParseIniToString(Data);
 }
 
+FIniPatch UIniLibrary::ComputeDiff(const FIniData& From, const FIniData& To)
+{
+	return FIniPatch::Compute(From, To);
+}
+
+bool UIniLibrary::ApplyPatch(FIniData& Data, const FIniPatch& Patch)
+{
+	return Patch.Apply(Data);
+}
+
 int32 UIniLibrary::GetNumOfSections(FIniData& Data)
 {
 	return Data.GetNumOfSections();
@@ -408,243 +572,294 @@ void UIniLibrary::GetGlobalComments(FIniData& Data, TArray<FString>& OutArray)
 	OutArray = Data.GetComments();
 }
 
+/**
+ * Property the typed getters and setters work on. Case-sensitive documents keep their properties in the keyed table, so they are
+ * looked up by the name's text there (an FName keeps the case it was first created with; use the ByKey functions for keys that
+ * differ only in case). As with GetProperty, the property has to exist.
+ */
+static FIniProperty& GetTypedProperty(FIniData& Data, const FName& SectionName, const FName& PropertyName)
+{
+	auto& Sect = Data.GetSection(SectionName);
+
+	if (Data.GetKeyMode() != EIniKeyMode::CaseSensitive)
+		return Sect.GetProperty(PropertyName);
+
+	FIniProperty* Property = Sect.FindPropertyByString(PropertyName.ToString());
+	checkf(Property, TEXT("Property %s not found in section %s"), *PropertyName.ToString(), *SectionName.ToString());
+
+	return *Property;
+}
+
+static FIniProperty& GetTypedGlobalProperty(FIniData& Data, const FName& PropertyName)
+{
+	if (Data.GetKeyMode() != EIniKeyMode::CaseSensitive)
+		return Data.GetProperty(PropertyName);
+
+	FIniProperty* Property = Data.FindPropertyByString(PropertyName.ToString());
+	checkf(Property, TEXT("Global property %s not found"), *PropertyName.ToString());
+
+	return *Property;
+}
+
 #pragma region Global Property Getters/Setters
 
 void UIniLibrary::GetPropertyValueAsInt(FIniData& Data, FName SectionName, FName PropertyName, int32& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsInt(OutValue);
 }
 
 void UIniLibrary::GetPropertyValueAsInt64(FIniData& Data, FName SectionName, FName PropertyName, int64& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsInt64(OutValue);
 }
 
 void UIniLibrary::GetPropertyValueAsBoolean(FIniData& Data, FName SectionName, FName PropertyName, bool& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsBoolean(OutValue);
 }
 
 void UIniLibrary::GetPropertyValueAsFloat(FIniData& Data, FName SectionName, FName PropertyName, float& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsFloat(OutValue);
 }
 
 void UIniLibrary::GetPropertyValueAsDouble(FIniData& Data, FName SectionName, FName PropertyName, double& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsDouble(OutValue);
 }
 
 void UIniLibrary::GetPropertyValueAsVector(FIniData& Data, FName SectionName, FName PropertyName, FVector& OutConvertedVector, bool& OutIsValid)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsVector(OutConvertedVector, OutIsValid);
 }
 
 void UIniLibrary::GetPropertyValueAsVector3f(FIniData& Data, FName SectionName, FName PropertyName, FVector3f& OutConvertedVector, bool& OutIsValid)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsVector3f(OutConvertedVector, OutIsValid);
 }
 
 void UIniLibrary::GetPropertyValueAsVector2D(FIniData& Data, FName SectionName, FName PropertyName, FVector2D& OutConvertedVector2D, bool& OutIsValid)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsVector2D(OutConvertedVector2D, OutIsValid);
 }
 
 void UIniLibrary::GetPropertyValueAsRotator(FIniData& Data, FName SectionName, FName PropertyName, FRotator& OutConvertedRotator, bool& OutIsValid)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsRotator(OutConvertedRotator, OutIsValid);
 }
 
 void UIniLibrary::GetPropertyValueAsLinearColor(FIniData& Data, FName SectionName, FName PropertyName, FLinearColor& OutConvertedColor, bool& OutIsValid)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.GetValueAsColor(OutConvertedColor, OutIsValid);
 }
 
 void UIniLibrary::GetPropertyValueAsName(FIniData& Data, FName SectionName, FName PropertyName, FName& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	OutValue = Prop.GetValueAsName();
 }
 
 void UIniLibrary::GetPropertyValueAsText(FIniData& Data, FName SectionName, FName PropertyName, FText& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	OutValue = FText::FromString(Prop.GetValueAsRawString());
 }
 
 void UIniLibrary::GetPropertyValueAsString(FIniData& Data, FName SectionName, FName PropertyName, FString& OutValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	OutValue = Prop.GetValueAsRawString();
 }
 
+void UIniLibrary::GetPropertyValueAsArray(FIniData& Data, FName SectionName, FName PropertyName, TArray<FString>& OutValues)
+{
+	FIniReadTelemetry::RecordRead(SectionName, PropertyName);
+
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
+	OutValues = Prop.IsArray() ? Prop.GetValues() : TArray<FString>{ Prop.GetValue() };
+}
+
+bool UIniLibrary::GetPropertyValueAsStringByKey(FIniData& Data, FName SectionName, FString Key, FString& OutValue)
+{
+	const FIniProperty* Property = nullptr;
+
+	if (SectionName.IsNone())
+		Property = Data.FindPropertyByString(Key);
+	else if (FIniSection* Section = Data.FindSection(SectionName))
+		Property = Section->FindPropertyByString(Key);
+
+	if (Property == nullptr)
+		return false;
+
+	OutValue = Property->GetValueAsRawString();
+	return true;
+}
+
 void UIniLibrary::SetPropertyValueAsString(FIniData& Data, FName SectionName, FName PropertyName, FString NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsString(NewValue);
 }
 
+void UIniLibrary::SetPropertyValueAsArray(FIniData& Data, FName SectionName, FName PropertyName, TArray<FString> NewValues)
+{
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
+	Prop.SetValues(MoveTemp(NewValues));
+}
+
 void UIniLibrary::SetPropertyValueAsText(FIniData& Data, FName SectionName, FName PropertyName, FText NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsText(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsName(FIniData& Data, FName SectionName, FName PropertyName, FName NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsName(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsObject(FIniData& Data, FName SectionName, FName PropertyName, UObject* NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsObject(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsByte(FIniData& Data, FName SectionName, FName PropertyName, uint8 NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsByte(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsInt(FIniData& Data, FName SectionName, FName PropertyName, int32 NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsInt(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsInt64(FIniData& Data, FName SectionName, FName PropertyName, int64 NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsInt64(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsIntPoint(FIniData& Data, FName SectionName, FName PropertyName, FIntPoint NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsIntPoint(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsBool(FIniData& Data, FName SectionName, FName PropertyName, bool bNewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsBoolean(bNewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsFloat(FIniData& Data, FName SectionName, FName PropertyName, float NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsFloat(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsDouble(FIniData& Data, FName SectionName, FName PropertyName, double NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsDouble(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsVector(FIniData& Data, FName SectionName, FName PropertyName, FVector NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsVector(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsVector2D(FIniData& Data, FName SectionName, FName PropertyName, FVector2D NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsVector2D(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsVector3f(FIniData& Data, FName SectionName, FName PropertyName, FVector3f NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsVector3f(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsIntVector(FIniData& Data, FName SectionName, FName PropertyName, FIntVector NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsIntVector(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsRotator(FIniData& Data, FName SectionName, FName PropertyName, FRotator NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsRotator(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsMatrix(FIniData& Data, FName SectionName, FName PropertyName, FMatrix NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsMatrix(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsTransform(FIniData& Data, FName SectionName, FName PropertyName, FTransform NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsTransform(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsLinearColor(FIniData& Data, FName SectionName, FName PropertyName, FLinearColor NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsColor(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsInputDeviceId(FIniData& Data, FName SectionName, FName PropertyName, FInputDeviceId NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsInputDeviceId(NewValue);
 }
 
 void UIniLibrary::SetPropertyValueAsPlatformUserId(FIniData& Data, FName SectionName, FName PropertyName, FPlatformUserId NewValue)
 {
-	auto& Sect = Data.GetSection(SectionName);
-	auto& Prop = Sect.GetProperty(PropertyName);
+	auto& Prop = GetTypedProperty(Data, SectionName, PropertyName);
 	Prop.SetValueAsPlatformUserId(NewValue);
 }
 
@@ -654,205 +869,245 @@ void UIniLibrary::SetPropertyValueAsPlatformUserId(FIniData& Data, FName Section
 
 void UIniLibrary::GetGlobalPropertyValueAsInt(FIniData& Data, FName PropertyName, int32& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsInt(OutValue);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsInt64(FIniData& Data, FName PropertyName, int64& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsInt64(OutValue);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsBoolean(FIniData& Data, FName PropertyName, bool& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsBoolean(OutValue);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsFloat(FIniData& Data, FName PropertyName, float& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsFloat(OutValue);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsDouble(FIniData& Data, FName PropertyName, double& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsDouble(OutValue);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsVector(FIniData& Data, FName PropertyName, FVector& OutConvertedVector, bool& OutIsValid)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsVector(OutConvertedVector, OutIsValid);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsVector3f(FIniData& Data, FName PropertyName, FVector3f& OutConvertedVector, bool& OutIsValid)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsVector3f(OutConvertedVector, OutIsValid);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsVector2D(FIniData& Data, FName PropertyName, FVector2D& OutConvertedVector2D, bool& OutIsValid)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsVector2D(OutConvertedVector2D, OutIsValid);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsRotator(FIniData& Data, FName PropertyName, FRotator& OutConvertedRotator, bool& OutIsValid)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsRotator(OutConvertedRotator, OutIsValid);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsLinearColor(FIniData& Data, FName PropertyName, FLinearColor& OutConvertedColor, bool& OutIsValid)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.GetValueAsColor(OutConvertedColor, OutIsValid);
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsName(FIniData& Data, FName PropertyName, FName& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	OutValue = Prop.GetValueAsName();
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsText(FIniData& Data, FName PropertyName, FText& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	OutValue = FText::FromString(Prop.GetValueAsRawString());
 }
 
 void UIniLibrary::GetGlobalPropertyValueAsString(FIniData& Data, FName PropertyName, FString& OutValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	OutValue = Prop.GetValueAsRawString();
 }
 
+void UIniLibrary::GetGlobalPropertyValueAsArray(FIniData& Data, FName PropertyName, TArray<FString>& OutValues)
+{
+	FIniReadTelemetry::RecordRead(NAME_None, PropertyName);
+
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
+	OutValues = Prop.IsArray() ? Prop.GetValues() : TArray<FString>{ Prop.GetValue() };
+}
+
 void UIniLibrary::SetGlobalPropertyValueAsString(FIniData& Data, FName PropertyName, FString NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsString(NewValue);
 }
 
+void UIniLibrary::SetGlobalPropertyValueAsArray(FIniData& Data, FName PropertyName, TArray<FString> NewValues)
+{
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
+	Prop.SetValues(MoveTemp(NewValues));
+}
+
 void UIniLibrary::SetGlobalPropertyValueAsText(FIniData& Data, FName PropertyName, FText NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsText(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsName(FIniData& Data, FName PropertyName, FName NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsName(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsObject(FIniData& Data, FName PropertyName, UObject* NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsObject(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsByte(FIniData& Data, FName PropertyName, uint8 NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsByte(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsInt(FIniData& Data, FName PropertyName, int32 NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsInt(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsInt64(FIniData& Data, FName PropertyName, int64 NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsInt64(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsIntPoint(FIniData& Data, FName PropertyName, FIntPoint NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsIntPoint(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsBool(FIniData& Data, FName PropertyName, bool bNewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsBoolean(bNewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsFloat(FIniData& Data, FName PropertyName, float NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsFloat(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsDouble(FIniData& Data, FName PropertyName, double NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsDouble(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsVector(FIniData& Data, FName PropertyName, FVector NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsVector(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsVector2D(FIniData& Data, FName PropertyName, FVector2D NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsVector2D(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsVector3f(FIniData& Data, FName PropertyName, FVector3f NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsVector3f(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsIntVector(FIniData& Data, FName PropertyName, FIntVector NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsIntVector(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsRotator(FIniData& Data, FName PropertyName, FRotator NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsRotator(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsMatrix(FIniData& Data, FName PropertyName, FMatrix NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsMatrix(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsTransform(FIniData& Data, FName PropertyName, FTransform NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsTransform(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsLinearColor(FIniData& Data, FName PropertyName, FLinearColor NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsColor(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsInputDeviceId(FIniData& Data, FName PropertyName, FInputDeviceId NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsInputDeviceId(NewValue);
 }
 
 void UIniLibrary::SetGlobalPropertyValueAsPlatformUserId(FIniData& Data, FName PropertyName, FPlatformUserId NewValue)
 {
-	auto& Prop = Data.GetProperty(PropertyName);
+	auto& Prop = GetTypedGlobalProperty(Data, PropertyName);
 	Prop.SetValueAsPlatformUserId(NewValue);
 }
 
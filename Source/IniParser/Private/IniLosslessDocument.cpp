@@ -0,0 +1,438 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniLosslessDocument.h"
+
+#include "IniDataBuilder.h"
+#include "IniParserModule.h"
+#include "IniPatch.h"
+#include "Algo/StableSort.h"
+
+#include "IniParserCore/IniWriter.h"
+
+/* Builds the data with the regular builder while recording where every entry is in the source */
+struct FIniLosslessIndexer
+{
+	typedef IniParserCore::TSpan<TCHAR> FSpan;
+
+	FIniLosslessDocument& Document;
+	FIniDataBuilder& Builder;
+	const TCHAR* SourceBegin;
+
+	int32 LineBegin = 0;
+	int32 LineEnd = 0;
+
+	FName CurrentSection = NAME_None;
+	FIniLosslessDocument::FSectionLayout* CurrentLayout = nullptr;
+
+	FORCEINLINE int32 ToOffset(const TCHAR* Char) const { return static_cast<int32>(Char - SourceBegin); }
+
+	void OnComment(FSpan Text)
+	{
+		Builder.OnComment(Text);
+
+		Document.Comments.FindOrAdd(CurrentSection).Add({ LineBegin, LineEnd, ToOffset(Text.Begin), ToOffset(Text.End) });
+		CurrentLayout->InsertAt = LineEnd;
+	}
+
+	void OnSection(FSpan Name)
+	{
+		Builder.OnSection(Name);
+
+		CurrentLayout->Blocks.Last().Value = LineBegin;
+
+		CurrentSection = FName(static_cast<int32>(Name.Len()), Name.Begin);
+		CurrentLayout = &Document.Sections.FindOrAdd(CurrentSection);
+		CurrentLayout->Blocks.Add({ LineBegin, Document.Source.Len() });
+		CurrentLayout->InsertAt = LineEnd;
+	}
+
+	void OnProperty(FSpan Key, FSpan RawValue)
+	{
+		Builder.OnProperty(Key, RawValue);
+
+		FSpan Name = Key;
+		const bool bArrayOp = IniParserCore::SplitArrayOp(Name) != IniParserCore::EArrayOp::None;
+
+		// The first plain definition wins, same as in the data; array operations all apply.
+		const FIniLosslessDocument::FKey PropertyKey{ CurrentSection, FName(static_cast<int32>(Name.Len()), Name.Begin) };
+		auto& Lines = Document.Properties.FindOrAdd(PropertyKey);
+
+		if (bArrayOp || Lines.IsEmpty())
+			Lines.Add({ LineBegin, LineEnd, ToOffset(RawValue.Begin), ToOffset(RawValue.End), bArrayOp });
+
+		CurrentLayout->InsertAt = LineEnd;
+	}
+};
+
+namespace IniLosslessDocument
+{
+	/* Text to splice into the source: [Begin, End) is replaced by Text */
+	struct FEdit
+	{
+		int32 Begin;
+		int32 End;
+		FString Text;
+	};
+
+	static FORCEINLINE bool IsQuote(TCHAR Char)
+	{
+		return Char == TEXT('"') || Char == TEXT('\'');
+	}
+
+	static FORCEINLINE bool IsQuoted(const TCHAR* Begin, int32 Len)
+	{
+		return Len >= 2 && IsQuote(Begin[0]) && Begin[Len - 1] == Begin[0];
+	}
+
+	// Quote a value the way the original line did, or the way the serializer would for new lines.
+	static void AppendValue(FString& Out, const FString& Value, TCHAR OriginalQuote)
+	{
+		int32 NewlineIndex;
+
+		// Only '"' can hold a multi-line value.
+		if (OriginalQuote == TEXT('\'') && Value.FindChar(TEXT('\n'), NewlineIndex))
+			OriginalQuote = TEXT('"');
+
+		if (OriginalQuote || IniParserCore::NeedsQuotes(IniParserCore::TSpan<TCHAR>{ *Value, *Value + Value.Len() }))
+		{
+			const TCHAR Quote = OriginalQuote ? OriginalQuote : TEXT('"');
+
+			Out.AppendChar(Quote);
+			Out += Value;
+			Out.AppendChar(Quote);
+		}
+		else
+		{
+			Out += Value;
+		}
+	}
+
+	static void AppendPropertyLine(FString& Out, const FName& Key, const FString& Value, const TCHAR* Newline)
+	{
+		Key.AppendString(Out);
+		Out += TEXT(" = ");
+		AppendValue(Out, Value, 0);
+		Out += Newline;
+	}
+
+	// One line for a plain value, one "+Key = ..." line per element for an array.
+	static void AppendPropertyLines(FString& Out, const FIniPatchEntry& Entry, const TCHAR* Newline)
+	{
+		if (Entry.Values.IsEmpty())
+		{
+			AppendPropertyLine(Out, Entry.Key, Entry.Value, Newline);
+			return;
+		}
+
+		for (const FString& Element : Entry.Values)
+		{
+			Out.AppendChar(TEXT('+'));
+			AppendPropertyLine(Out, Entry.Key, Element, Newline);
+		}
+	}
+
+	// See IniParserCore::IsWritable; such values keep their old text.
+	static bool IsWritable(const FIniPatchEntry& Entry)
+	{
+		bool bWritable = IniParserCore::IsWritable(IniParserCore::TSpan<TCHAR>{ *Entry.Value, *Entry.Value + Entry.Value.Len() });
+
+		for (const FString& Element : Entry.Values)
+			bWritable &= IniParserCore::IsWritable(IniParserCore::TSpan<TCHAR>{ *Element, *Element + Element.Len() });
+
+		return bWritable;
+	}
+
+	static void AppendCommentLine(FString& Out, const FString& Comment, const TCHAR* Newline)
+	{
+		Out += TEXT("; ");
+		Out += Comment;
+		Out += Newline;
+	}
+}
+
+FIniLosslessDocument::FIniLosslessDocument(FString NewSource)
+{
+	Parse(MoveTemp(NewSource));
+}
+
+bool FIniLosslessDocument::LoadFromFile(const FString& FilePath, FIniLosslessDocument& OutDocument)
+{
+	TArray<uint8> Bytes;
+
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+		return false;
+
+	// Remember the encoding, so saving does not turn a UTF-8 file into UTF-16 or drop its BOM.
+	if (Bytes.Num() >= 3 && Bytes[0] == 0xEF && Bytes[1] == 0xBB && Bytes[2] == 0xBF)
+		OutDocument.Encoding = FFileHelper::EEncodingOptions::ForceUTF8;
+	else if (Bytes.Num() >= 2 && ((Bytes[0] == 0xFF && Bytes[1] == 0xFE) || (Bytes[0] == 0xFE && Bytes[1] == 0xFF)))
+		OutDocument.Encoding = FFileHelper::EEncodingOptions::ForceUnicode;
+	else
+		OutDocument.Encoding = FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM;
+
+	FString Text;
+	FFileHelper::BufferToString(Text, Bytes.GetData(), Bytes.Num());
+
+	OutDocument.Parse(MoveTemp(Text));
+	return true;
+}
+
+void FIniLosslessDocument::Parse(FString NewSource)
+{
+	Source = MoveTemp(NewSource);
+	Data = FIniData();
+	Sections.Reset();
+	Properties.Reset();
+	Comments.Reset();
+
+	const TCHAR* Begin = *Source;
+	const TCHAR* End = Begin + Source.Len();
+
+	TArray<FIniEntryCounts> EntryCounts;
+	CountEntries(Source, EntryCounts);
+
+	FIniDataBuilder Builder{ Data, EntryCounts };
+	FIniLosslessIndexer Indexer{ *this, Builder, Begin };
+
+	Indexer.CurrentLayout = &Sections.Add(NAME_None);
+	Indexer.CurrentLayout->Blocks.Add({ 0, Source.Len() });
+
+	for (const TCHAR* Cursor = Begin; Cursor < End;)
+	{
+		const TCHAR* LineEnd = IniParserCore::FindEntryEnd(Cursor, End);
+		const TCHAR* NextLine = LineEnd < End ? LineEnd + 1 : End;
+
+		Indexer.LineBegin = Indexer.ToOffset(Cursor);
+		Indexer.LineEnd = Indexer.ToOffset(NextLine);
+
+		IniParserCore::TokenizeLine(Cursor, LineEnd, Indexer);
+		Cursor = NextLine;
+	}
+
+	bCRLF = Source.Contains(TEXT("\r\n"), ESearchCase::CaseSensitive);
+
+	// References handed out earlier still point at Data, so edits made through them after a reload must be diffed too.
+	if (bDataExposed)
+		Snapshot = Data;
+}
+
+FIniData& FIniLosslessDocument::GetData()
+{
+	if (!bDataExposed)
+	{
+		Snapshot = Data;
+		bDataExposed = true;
+	}
+
+	return Data;
+}
+
+bool FIniLosslessDocument::IsModified() const
+{
+	return bDataExposed && !FIniPatch::Compute(Snapshot, Data).IsEmpty();
+}
+
+FString FIniLosslessDocument::ToString() const
+{
+	using namespace IniLosslessDocument;
+
+	if (!bDataExposed)
+		return Source;
+
+	const FIniPatch Patch = FIniPatch::Compute(Snapshot, Data);
+
+	if (Patch.IsEmpty())
+		return Source;
+
+	const TCHAR* Newline = bCRLF ? TEXT("\r\n") : TEXT("\n");
+	const bool bEndsWithNewline = Source.EndsWith(TEXT("\n"), ESearchCase::CaseSensitive);
+
+	TArray<FEdit> Edits;
+	FString Appended;
+
+	TSet<FName> NewSections;
+	TMap<FName, TBitArray<>> RemovedComments;
+
+	auto InsertLine = [&](const FName& Section, FString&& Line)
+	{
+		if (NewSections.Contains(Section))
+		{
+			Appended += Line;
+			return;
+		}
+
+		const int32 Offset = Sections.FindChecked(Section).InsertAt;
+
+		// The last line of the source may have no newline to insert after.
+		if (Offset == Source.Len() && !Source.IsEmpty() && !bEndsWithNewline)
+			Line.InsertAt(0, Newline);
+
+		Edits.Add({ Offset, Offset, MoveTemp(Line) });
+	};
+
+	for (const FIniPatchEntry& Entry : Patch.GetEntries())
+	{
+		switch (Entry.Operation)
+		{
+			case EIniPatchOperation::AddSection:
+			{
+				NewSections.Add(Entry.Section);
+
+				if (!Source.IsEmpty() || !Appended.IsEmpty())
+					Appended += Newline;
+
+				Appended.AppendChar(TEXT('['));
+				Entry.Section.AppendString(Appended);
+				Appended.AppendChar(TEXT(']'));
+				Appended += Newline;
+				break;
+			}
+
+			case EIniPatchOperation::RemoveSection:
+			{
+				if (const FSectionLayout* Layout = Sections.Find(Entry.Section))
+				{
+					for (const TPair<int32, int32>& Block : Layout->Blocks)
+						Edits.Add({ Block.Key, Block.Value, FString() });
+				}
+				break;
+			}
+
+			case EIniPatchOperation::SetProperty:
+			{
+				if (!IsWritable(Entry))
+				{
+					UE_LOG(LogIniParser, Error, TEXT("ERROR: Can not write %s, a line of its multi-line value would be read as the end of the value or as another entry"), *Entry.Key.ToString());
+					break;
+				}
+
+				const TArray<FLineLayout, TInlineAllocator<1>>* Layouts = Properties.Find({ Entry.Section, Entry.Key });
+
+				if (!Layouts || Layouts->IsEmpty())
+				{
+					FString Lines;
+					AppendPropertyLines(Lines, Entry, Newline);
+					InsertLine(Entry.Section, MoveTemp(Lines));
+				}
+				else if (Layouts->Num() == 1 && !(*Layouts)[0].bArrayOp && Entry.Values.IsEmpty())
+				{
+					// A plain value stays plain: only the value text is replaced.
+					const FLineLayout& Layout = (*Layouts)[0];
+					const TCHAR* Raw = *Source + Layout.TextBegin;
+					const int32 RawLen = Layout.TextEnd - Layout.TextBegin;
+
+					FString Text;
+					AppendValue(Text, Entry.Value, IsQuoted(Raw, RawLen) ? Raw[0] : 0);
+
+					Edits.Add({ Layout.TextBegin, Layout.TextEnd, MoveTemp(Text) });
+				}
+				else
+				{
+					// Arrays are rewritten where their first line was.
+					const FLineLayout& First = (*Layouts)[0];
+
+					FString Lines;
+					AppendPropertyLines(Lines, Entry, Newline);
+
+					if (First.LineEnd == Source.Len() && !bEndsWithNewline)
+						Lines.LeftChopInline(FCString::Strlen(Newline));
+
+					Edits.Add({ First.LineBegin, First.LineEnd, MoveTemp(Lines) });
+
+					for (int32 Index = 1; Index < Layouts->Num(); Index++)
+						Edits.Add({ (*Layouts)[Index].LineBegin, (*Layouts)[Index].LineEnd, FString() });
+				}
+				break;
+			}
+
+			case EIniPatchOperation::RemoveProperty:
+			{
+				if (const TArray<FLineLayout, TInlineAllocator<1>>* Layouts = Properties.Find({ Entry.Section, Entry.Key }))
+				{
+					for (const FLineLayout& Layout : *Layouts)
+						Edits.Add({ Layout.LineBegin, Layout.LineEnd, FString() });
+				}
+				break;
+			}
+
+			case EIniPatchOperation::AddComment:
+			{
+				FString Line;
+				AppendCommentLine(Line, Entry.Value, Newline);
+				InsertLine(Entry.Section, MoveTemp(Line));
+				break;
+			}
+
+			case EIniPatchOperation::RemoveComment:
+			{
+				const TArray<FLineLayout>* Layouts = Comments.Find(Entry.Section);
+
+				if (!Layouts)
+					break;
+
+				TBitArray<>& Removed = RemovedComments.FindOrAdd(Entry.Section, TBitArray<>(false, Layouts->Num()));
+
+				for (int32 Index = 0; Index < Layouts->Num(); Index++)
+				{
+					const FLineLayout& Layout = (*Layouts)[Index];
+
+					if (!Removed[Index] && Layout.TextEnd - Layout.TextBegin == Entry.Value.Len()
+						&& FCString::Strncmp(*Source + Layout.TextBegin, *Entry.Value, Entry.Value.Len()) == 0)
+					{
+						Removed[Index] = true;
+						Edits.Add({ Layout.LineBegin, Layout.LineEnd, FString() });
+						break;
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	// Inserts at the same offset keep their patch order.
+	Algo::StableSortBy(Edits, &FEdit::Begin);
+
+	FString Output;
+	Output.Reserve(Source.Len() + Appended.Len() + 64);
+
+	int32 Cursor = 0;
+
+	for (const FEdit& Edit : Edits)
+	{
+		// Edits inside a removed range are dropped with it.
+		if (Edit.Begin < Cursor)
+			continue;
+
+		Output.AppendChars(*Source + Cursor, Edit.Begin - Cursor);
+		Output += Edit.Text;
+		Cursor = Edit.End;
+	}
+
+	Output.AppendChars(*Source + Cursor, Source.Len() - Cursor);
+
+	if (!Appended.IsEmpty())
+	{
+		if (!Output.IsEmpty() && !Output.EndsWith(TEXT("\n"), ESearchCase::CaseSensitive))
+			Output += Newline;
+
+		Output += Appended;
+	}
+
+	return Output;
+}
+
+bool FIniLosslessDocument::SaveToFile(const FString& FilePath)
+{
+	FString Text = ToString();
+
+	if (!FFileHelper::SaveStringToFile(Text, *FilePath, Encoding))
+		return false;
+
+	// Re-index only when the text changed; otherwise the recorded offsets are still valid.
+	if (!Text.Equals(Source, ESearchCase::CaseSensitive))
+		Parse(MoveTemp(Text));
+	else if (bDataExposed)
+		Snapshot = Data;
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniPack.h"
+
+#include "IniDataBuilder.h"
+#include "IniParserModule.h"
+#include "IniParserStats.h"
+
+#include "Algo/BinarySearch.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Hash/CityHash.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Serialization/MemoryReader.h"
+
+namespace IniPack
+{
+	// Tokenize one UTF-8 document into a fresh data object.
+	static int32 ParseUtf8(const char* Begin, const char* End, FIniData& OutData)
+	{
+		OutData = FIniData();
+
+		TArray<FIniEntryCounts> EntryCounts;
+		EntryCounts.AddDefaulted();
+
+		FIniDataBuilder Builder{ OutData, EntryCounts };
+		FIniUtf8DataBuilder Utf8Builder{ Builder };
+
+		IniParserCore::Tokenize(Begin, End, Utf8Builder);
+
+		return Builder.NumEntries;
+	}
+}
+
+uint64 FIniPack::HashPath(const FString& RelativePath)
+{
+	FString Normalized = RelativePath;
+	Normalized.ReplaceCharInline(TEXT('\\'), TEXT('/'));
+	Normalized.ToLowerInline();
+
+	while (Normalized.StartsWith(TEXT("./")))
+		Normalized.RightChopInline(2);
+
+	while (Normalized.StartsWith(TEXT("/")))
+		Normalized.RightChopInline(1);
+
+	const FTCHARToUTF8 Utf8(*Normalized, Normalized.Len());
+	return CityHash64(Utf8.Get(), Utf8.Length());
+}
+
+bool FIniPack::Build(const FString& Directory, const FString& OutputPath, const FString& Wildcard)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIniPack::Build);
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *Directory, *Wildcard, true, false);
+	Files.Sort();
+
+	const FString Root = FPaths::ConvertRelativePathToFull(Directory) / TEXT("");
+
+	TArray<FEntry> Table;
+	Table.Reserve(Files.Num());
+
+	TMap<uint64, FString> Paths;
+	TArray64<uint8> Blob;
+
+	for (const FString& File : Files)
+	{
+		FString RelativePath = FPaths::ConvertRelativePathToFull(File);
+		FPaths::MakePathRelativeTo(RelativePath, *Root);
+
+		FEntry Entry;
+		Entry.Hash = HashPath(RelativePath);
+
+		if (const FString* Existing = Paths.Find(Entry.Hash))
+		{
+			UE_LOG(LogIniParser, Error, TEXT("ERROR: %s and %s have the same path hash, rename one of them."), **Existing, *RelativePath);
+			return false;
+		}
+
+		Paths.Add(Entry.Hash, RelativePath);
+
+		// Store every document as UTF-8, whatever encoding the source file used.
+		FString Text;
+
+		if (!FFileHelper::LoadFileToString(Text, *File))
+		{
+			UE_LOG(LogIniParser, Error, TEXT("ERROR: Can not read %s"), *File);
+			return false;
+		}
+
+		const FTCHARToUTF8 Utf8(*Text, Text.Len());
+
+		Entry.Offset = static_cast<uint64>(Blob.Num());
+		Entry.Length = static_cast<uint32>(Utf8.Length());
+
+		Blob.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		Table.Add(Entry);
+	}
+
+	Table.Sort([](const FEntry& A, const FEntry& B) { return A.Hash < B.Hash; });
+
+	const uint64 BlobOffset = static_cast<uint64>(HEADER_SIZE + ENTRY_SIZE * Table.Num());
+
+	for (FEntry& Entry : Table)
+		Entry.Offset += BlobOffset;
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*OutputPath));
+
+	if (!Writer)
+	{
+		UE_LOG(LogIniParser, Error, TEXT("ERROR: Can not write %s"), *OutputPath);
+		return false;
+	}
+
+	uint32 Magic = MAGIC;
+	uint32 Version = VERSION;
+	uint32 NumEntries = static_cast<uint32>(Table.Num());
+	uint32 Reserved = 0;
+
+	*Writer << Magic << Version << NumEntries << Reserved;
+
+	for (FEntry& Entry : Table)
+		*Writer << Entry;
+
+	Writer->Serialize(Blob.GetData(), Blob.Num());
+
+	UE_LOG(LogIniParser, Log, TEXT("Packed %d .ini files (%lld bytes) into %s"), Table.Num(), Blob.Num(), *OutputPath);
+
+	return Writer->Close();
+}
+
+FIniPack::FIniPack()
+{ }
+
+FIniPack::~FIniPack()
+{
+	Close();
+}
+
+bool FIniPack::Open(const FString& InPackPath, bool bMemoryMap)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIniPack::Open);
+
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (bMemoryMap)
+	{
+		MappedFile.Reset(PlatformFile.OpenMapped(*InPackPath));
+
+		if (MappedFile)
+			MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+
+		if (MappedRegion)
+		{
+			if (!ReadTableOfContents(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), MappedRegion->GetMappedSize()))
+			{
+				Close();
+				return false;
+			}
+
+			PackPath = InPackPath;
+			return true;
+		}
+
+		// No mapping on this platform, read through a handle instead.
+		MappedFile.Reset();
+	}
+
+	FileHandle.Reset(PlatformFile.OpenRead(*InPackPath));
+
+	if (!FileHandle)
+	{
+		UE_LOG(LogIniParser, Warning, TEXT("ERROR: Can not read the file because it was not found."));
+		UE_LOG(LogIniParser, Warning, TEXT("Expected file location: %s"), *InPackPath);
+		return false;
+	}
+
+	TArray<uint8> Header;
+	Header.SetNumUninitialized(HEADER_SIZE);
+
+	if (!FileHandle->Read(Header.GetData(), HEADER_SIZE))
+	{
+		Close();
+		return false;
+	}
+
+	const uint32 NumEntries = *reinterpret_cast<const uint32*>(Header.GetData() + 8);
+
+	if (HEADER_SIZE + ENTRY_SIZE * NumEntries > FMath::Min<int64>(FileHandle->Size(), MAX_int32))
+	{
+		Close();
+		return false;
+	}
+
+	Header.AddUninitialized(ENTRY_SIZE * NumEntries);
+
+	if (!FileHandle->Read(Header.GetData() + HEADER_SIZE, ENTRY_SIZE * NumEntries) || !ReadTableOfContents(Header.GetData(), Header.Num(), FileHandle->Size()))
+	{
+		Close();
+		return false;
+	}
+
+	PackPath = InPackPath;
+	return true;
+}
+
+bool FIniPack::ReadTableOfContents(const uint8* Data, int64 Size, int64 FileSize)
+{
+	if (Size < HEADER_SIZE)
+		return false;
+
+	TArrayView<const uint8> View(Data, static_cast<int32>(FMath::Min<int64>(Size, MAX_int32)));
+	FMemoryReaderView Reader(View);
+
+	uint32 Magic, Version, NumEntries, Reserved;
+	Reader << Magic << Version << NumEntries << Reserved;
+
+	if (Magic != MAGIC || Version != VERSION || HEADER_SIZE + ENTRY_SIZE * NumEntries > Size)
+	{
+		UE_LOG(LogIniParser, Warning, TEXT("ERROR: Not a valid .ini pack"));
+		return false;
+	}
+
+	Entries.SetNum(NumEntries);
+
+	for (FEntry& Entry : Entries)
+		Reader << Entry;
+
+	if (Reader.IsError())
+		return false;
+
+	// Checked once here so ReadDocument can trust every entry. Documents are read into int32-sized buffers.
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FEntry& Entry = Entries[Index];
+
+		if (Entry.Offset > static_cast<uint64>(FileSize)
+			|| Entry.Length > static_cast<uint64>(FileSize) - Entry.Offset
+			|| Entry.Length > static_cast<uint32>(MAX_int32)
+			|| (Index > 0 && Entries[Index - 1].Hash >= Entry.Hash))
+		{
+			UE_LOG(LogIniParser, Warning, TEXT("ERROR: Not a valid .ini pack"));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FIniPack::Close()
+{
+	FScopeLock Lock(&FileLock);
+
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FileHandle.Reset();
+	Entries.Reset();
+	PackPath.Reset();
+}
+
+const FIniPack::FEntry* FIniPack::FindEntry(const FString& RelativePath) const
+{
+	const uint64 Hash = HashPath(RelativePath);
+	const int32 Index = Algo::BinarySearchBy(Entries, Hash, &FEntry::Hash);
+
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+bool FIniPack::Contains(const FString& RelativePath) const
+{
+	return FindEntry(RelativePath) != nullptr;
+}
+
+bool FIniPack::ReadDocument(const FString& RelativePath, FIniData& OutData) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIniPack::ReadDocument);
+
+	const FEntry* Entry = FindEntry(RelativePath);
+
+	if (!Entry)
+		return false;
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumEntries = 0;
+
+	if (MappedRegion)
+	{
+		// Parse straight from the mapping, nothing is copied.
+		const char* Begin = reinterpret_cast<const char*>(MappedRegion->GetMappedPtr() + Entry->Offset);
+		NumEntries = IniPack::ParseUtf8(Begin, Begin + Entry->Length, OutData);
+	}
+	else
+	{
+		TArray<char> Buffer;
+		Buffer.SetNumUninitialized(static_cast<int32>(Entry->Length));
+
+		{
+			FScopeLock Lock(&FileLock);
+
+			if (!FileHandle || !FileHandle->Seek(static_cast<int64>(Entry->Offset)) || !FileHandle->Read(reinterpret_cast<uint8*>(Buffer.GetData()), Entry->Length))
+				return false;
+		}
+
+		NumEntries = IniPack::ParseUtf8(Buffer.GetData(), Buffer.GetData() + Buffer.Num(), OutData);
+	}
+
+	if (FIniParserStats::IsEnabled())
+		FIniParserStats::RecordRead(PackPath / RelativePath, Entry->Length, 0, NumEntries, FPlatformTime::Seconds() - StartTime);
+
+	return true;
+}
\ No newline at end of file
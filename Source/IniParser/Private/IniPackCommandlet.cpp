@@ -0,0 +1,33 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniPackCommandlet.h"
+
+#include "IniPack.h"
+#include "IniParserModule.h"
+
+UIniPackCommandlet::UIniPackCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UIniPackCommandlet::Main(const FString& Params)
+{
+	FString Source;
+	FString Output;
+	FString Wildcard = TEXT("*.ini");
+
+	FParse::Value(*Params, TEXT("Source="), Source);
+	FParse::Value(*Params, TEXT("Output="), Output);
+	FParse::Value(*Params, TEXT("Wildcard="), Wildcard);
+
+	if (Source.IsEmpty() || Output.IsEmpty())
+	{
+		UE_LOG(LogIniParser, Error, TEXT("Usage: -run=IniPack -Source=<Directory> -Output=<PackFile> [-Wildcard=*.ini]"));
+		return 1;
+	}
+
+	return FIniPack::Build(Source, Output, Wildcard) ? 0 : 1;
+}
\ No newline at end of file
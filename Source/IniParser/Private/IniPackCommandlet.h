@@ -0,0 +1,22 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "IniPackCommandlet.generated.h"
+
+/**
+ * Build step for FIniPack.
+ * Usage: -run=IniPack -Source=<Directory> -Output=<PackFile> [-Wildcard=*.ini]
+ */
+UCLASS()
+class UIniPackCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UIniPackCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
@@ -0,0 +1,111 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniParserStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/OutputDevice.h"
+
+namespace IniParserStats
+{
+	static bool bEnabled = true;
+
+	static FAutoConsoleVariableRef CVarEnable(
+		TEXT("IniParser.Stats.Enable"),
+		bEnabled,
+		TEXT("Record per-file ini parse and write stats (bytes, lines, entries, durations)."));
+
+	static FCriticalSection Lock;
+	static TMap<FString, FIniSourceStats> Sources;
+
+	static FAutoConsoleCommandWithOutputDevice DumpCommand(
+		TEXT("IniParser.Stats.Dump"),
+		TEXT("Print cumulative ini parse and write stats per file."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FIniParserStats::Dump));
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("IniParser.Stats.Reset"),
+		TEXT("Clear the cumulative ini parse and write stats."),
+		FConsoleCommandDelegate::CreateStatic(&FIniParserStats::Reset));
+}
+
+const TCHAR* FIniParserStats::STRING_SOURCE = TEXT("<string>");
+
+bool FIniParserStats::IsEnabled()
+{
+	return IniParserStats::bEnabled;
+}
+
+void FIniParserStats::RecordRead(const FString& Source, int64 Bytes, int64 Lines, int64 Entries, double Seconds)
+{
+	FScopeLock Lock(&IniParserStats::Lock);
+	FIniSourceStats& Stats = IniParserStats::Sources.FindOrAdd(Source);
+
+	Stats.NumReads++;
+	Stats.BytesRead += Bytes;
+	Stats.LinesRead += Lines;
+	Stats.EntriesRead += Entries;
+	Stats.ReadSeconds += Seconds;
+}
+
+void FIniParserStats::RecordWrite(const FString& Source, int64 Bytes, int64 Lines, double Seconds)
+{
+	FScopeLock Lock(&IniParserStats::Lock);
+	FIniSourceStats& Stats = IniParserStats::Sources.FindOrAdd(Source);
+
+	Stats.NumWrites++;
+	Stats.BytesWritten += Bytes;
+	Stats.LinesWritten += Lines;
+	Stats.WriteSeconds += Seconds;
+}
+
+TMap<FString, FIniSourceStats> FIniParserStats::GetSnapshot()
+{
+	FScopeLock Lock(&IniParserStats::Lock);
+	return IniParserStats::Sources;
+}
+
+void FIniParserStats::Reset()
+{
+	FScopeLock Lock(&IniParserStats::Lock);
+	IniParserStats::Sources.Reset();
+}
+
+void FIniParserStats::Dump(FOutputDevice& Output)
+{
+	TMap<FString, FIniSourceStats> Snapshot = GetSnapshot();
+
+	Snapshot.ValueSort([](const FIniSourceStats& A, const FIniSourceStats& B)
+	{
+		return A.ReadSeconds + A.WriteSeconds > B.ReadSeconds + B.WriteSeconds;
+	});
+
+	FIniSourceStats Total;
+
+	Output.Logf(TEXT("IniParser stats (%d sources)"), Snapshot.Num());
+	Output.Logf(TEXT("%8s %10s %12s %10s %10s %8s %10s %12s  %s"),
+		TEXT("Reads"), TEXT("Read ms"), TEXT("Bytes read"), TEXT("Lines"), TEXT("Entries"),
+		TEXT("Writes"), TEXT("Write ms"), TEXT("Bytes out"), TEXT("Source"));
+
+	for (const auto& Pair : Snapshot)
+	{
+		const FIniSourceStats& Stats = Pair.Value;
+
+		Output.Logf(TEXT("%8d %10.3f %12lld %10lld %10lld %8d %10.3f %12lld  %s"),
+			Stats.NumReads, Stats.ReadSeconds * 1000.0, Stats.BytesRead, Stats.LinesRead, Stats.EntriesRead,
+			Stats.NumWrites, Stats.WriteSeconds * 1000.0, Stats.BytesWritten, *Pair.Key);
+
+		Total.NumReads += Stats.NumReads;
+		Total.NumWrites += Stats.NumWrites;
+		Total.BytesRead += Stats.BytesRead;
+		Total.BytesWritten += Stats.BytesWritten;
+		Total.LinesRead += Stats.LinesRead;
+		Total.EntriesRead += Stats.EntriesRead;
+		Total.ReadSeconds += Stats.ReadSeconds;
+		Total.WriteSeconds += Stats.WriteSeconds;
+	}
+
+	Output.Logf(TEXT("%8d %10.3f %12lld %10lld %10lld %8d %10.3f %12lld  %s"),
+		Total.NumReads, Total.ReadSeconds * 1000.0, Total.BytesRead, Total.LinesRead, Total.EntriesRead,
+		Total.NumWrites, Total.WriteSeconds * 1000.0, Total.BytesWritten, TEXT("Total"));
+}
\ No newline at end of file
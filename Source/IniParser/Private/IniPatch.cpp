@@ -0,0 +1,194 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniPatch.h"
+
+#include "IniParserModule.h"
+
+namespace IniPatch
+{
+	/* Comment text compared case-sensitively, mapped to how many times it occurs */
+	struct FCommentCountKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+	{
+		static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/* Entry for a section, or for the global scope if Section is null */
+	template <typename ValueType>
+	static FORCEINLINE FIniPatchEntry MakeEntry(EIniPatchOperation Operation, const FName* Section, const FName& Key, const ValueType& Value)
+	{
+		return Section ? FIniPatchEntry(Operation, *Section, Key, Value) : FIniPatchEntry(Operation, Key, Value);
+	}
+
+	static void DiffComments(const FName* Section, const TArray<FString>& From, const TArray<FString>& To, FIniPatch& OutPatch)
+	{
+		if (From.IsEmpty() && To.IsEmpty())
+			return;
+
+		// Occurrences of each comment in From that no comment in To has matched yet.
+		TMap<FString, int32, FDefaultSetAllocator, FCommentCountKeyFuncs> Unmatched;
+		Unmatched.Reserve(From.Num());
+
+		for (const FString& Comment : From)
+			Unmatched.FindOrAdd(Comment, 0)++;
+
+		for (const FString& Comment : To)
+		{
+			int32* Count = Unmatched.Find(Comment);
+
+			if (Count && *Count > 0)
+				--*Count;
+			else
+				OutPatch.AddEntry(MakeEntry(EIniPatchOperation::AddComment, Section, NAME_None, Comment));
+		}
+
+		// Equal comments are interchangeable, so the first occurrences in From count as the matched ones.
+		for (const FString& Comment : From)
+		{
+			int32& Count = Unmatched.FindChecked(Comment);
+
+			if (Count > 0)
+			{
+				--Count;
+				OutPatch.AddEntry(MakeEntry(EIniPatchOperation::RemoveComment, Section, NAME_None, Comment));
+			}
+		}
+	}
+
+	static void DiffProperties(const FName* Section, const TMap<FName, FIniProperty>& From, const TMap<FName, FIniProperty>& To, FIniPatch& OutPatch)
+	{
+		for (const auto& PropertyPair : To)
+		{
+			const FIniProperty* Previous = From.Find(PropertyPair.Key);
+
+			if (!Previous || *Previous != PropertyPair.Value)
+				OutPatch.AddEntry(MakeEntry(EIniPatchOperation::SetProperty, Section, PropertyPair.Key, PropertyPair.Value));
+		}
+
+		// Only keys missing from To are left to visit; everything else was handled above.
+		if (From.Num() == 0)
+			return;
+
+		for (const auto& PropertyPair : From)
+		{
+			if (!To.Contains(PropertyPair.Key))
+				OutPatch.AddEntry(MakeEntry(EIniPatchOperation::RemoveProperty, Section, PropertyPair.Key, FString()));
+		}
+	}
+}
+
+FIniPatch FIniPatch::Compute(const FIniData& From, const FIniData& To)
+{
+	FIniPatch Patch;
+
+	// Entries name properties by FName, which can not hold a case-sensitive key.
+	if (!ensureMsgf(!From.HasKeyedProperties() && !To.HasKeyedProperties(), TEXT("FIniPatch::Compute does not support case-sensitive keys, returning an empty patch")))
+		return Patch;
+
+	IniPatch::DiffComments(nullptr, From.GetComments(), To.GetComments(), Patch);
+	IniPatch::DiffProperties(nullptr, From.GetProperties(), To.GetProperties(), Patch);
+
+	static const TMap<FName, FIniProperty> EmptyProperties;
+	static const TArray<FString> EmptyComments;
+
+	for (const auto& SectionPair : To.GetSections())
+	{
+		const FIniSection* Previous = From.GetSections().Find(SectionPair.Key);
+
+		if (!Previous)
+			Patch.AddEntry(FIniPatchEntry(EIniPatchOperation::AddSection, SectionPair.Key, NAME_None, FString()));
+
+		IniPatch::DiffComments(&SectionPair.Key, Previous ? Previous->GetComments() : EmptyComments, SectionPair.Value.GetComments(), Patch);
+		IniPatch::DiffProperties(&SectionPair.Key, Previous ? Previous->GetProperties() : EmptyProperties, SectionPair.Value.GetProperties(), Patch);
+	}
+
+	for (const auto& SectionPair : From.GetSections())
+	{
+		if (!To.HasSection(SectionPair.Key))
+			Patch.AddEntry(FIniPatchEntry(EIniPatchOperation::RemoveSection, SectionPair.Key, NAME_None, FString()));
+	}
+
+	return Patch;
+}
+
+bool FIniPatch::Apply(FIniData& Data) const
+{
+	// FName keys would be added next to the keyed properties and written twice.
+	if (Data.HasKeyedProperties())
+	{
+		UE_LOG(LogIniParser, Error, TEXT("ERROR: Can not apply a patch to a document with case-sensitive keys, the document is left unchanged"));
+		return false;
+	}
+
+	// Entries are grouped by section, so only look the section up again when it changes.
+	FName CurrentSectionName = NAME_None;
+	FIniSection* CurrentSection = nullptr;
+
+	for (const FIniPatchEntry& Entry : Entries)
+	{
+		const bool bGlobal = Entry.bGlobal;
+
+		if (!bGlobal && (Entry.Section != CurrentSectionName || !CurrentSection))
+		{
+			CurrentSectionName = Entry.Section;
+			CurrentSection = Data.FindSection(Entry.Section);
+		}
+
+		switch (Entry.Operation)
+		{
+			case EIniPatchOperation::AddSection:
+				CurrentSection = &Data.FindOrAddSection(Entry.Section);
+				break;
+
+			case EIniPatchOperation::RemoveSection:
+				Data.RemoveSection(Entry.Section);
+				CurrentSection = nullptr;
+				break;
+
+			case EIniPatchOperation::SetProperty:
+				if (bGlobal)
+					Data.FindOrAddProperty(Entry.Key, FString()) = Entry.MakeProperty();
+				else
+				{
+					if (!CurrentSection)
+						CurrentSection = &Data.FindOrAddSection(Entry.Section);
+
+					CurrentSection->FindOrAddProperty(Entry.Key, FString()) = Entry.MakeProperty();
+				}
+				break;
+
+			case EIniPatchOperation::RemoveProperty:
+				if (bGlobal)
+					Data.RemoveProperty(Entry.Key);
+				else if (CurrentSection)
+					CurrentSection->RemoveProperty(Entry.Key);
+				break;
+
+			case EIniPatchOperation::AddComment:
+				if (bGlobal)
+					Data.AddComment(Entry.Value);
+				else
+				{
+					if (!CurrentSection)
+						CurrentSection = &Data.FindOrAddSection(Entry.Section);
+
+					CurrentSection->AddComment(Entry.Value);
+				}
+				break;
+
+			case EIniPatchOperation::RemoveComment:
+				if (bGlobal)
+					Data.RemoveComment(Entry.Value);
+				else if (CurrentSection)
+					CurrentSection->RemoveComment(Entry.Value);
+				break;
+		}
+	}
+
+	return true;
+}
+
+void FIniPatch::AddEntry(FIniPatchEntry Entry)
+{
+	Entries.Add(MoveTemp(Entry));
+}
\ No newline at end of file
@@ -3,108 +3,224 @@
 #include "IniProperty.h"
 
 #include "IniParserModule.h"
+#include "IniValueFormatter.h"
+
+#include "IniParserCore/IniWriter.h"
+
+FString FIniProperty::GetValueReadableString() const
+{
+	if (!IniParserCore::NeedsQuotes(IniParserCore::TSpan<TCHAR>{ *Value, *Value + Value.Len() }))
+		return Value;
+
+	FString Result;
+	Result.Reserve(Value.Len() + 2);
+	Result.AppendChar(TEXT('"'));
+	Result.Append(Value);
+	Result.AppendChar(TEXT('"'));
+
+	return Result;
+}
+
+void FIniProperty::AddValue(FString NewValue)
+{
+	if (Values.IsEmpty() && !Value.IsEmpty())
+		Values.Add(MoveTemp(Value));
+
+	Value.Reset();
+	Values.Add(MoveTemp(NewValue));
+}
+
+int32 FIniProperty::RemoveValue(const FString& OldValue)
+{
+	if (Values.IsEmpty())
+	{
+		if (!Value.Equals(OldValue, ESearchCase::CaseSensitive))
+			return 0;
+
+		Value.Reset();
+		return 1;
+	}
+
+	return Values.RemoveAll([&OldValue](const FString& Element)
+	{
+		return Element.Equals(OldValue, ESearchCase::CaseSensitive);
+	});
+}
+
+void FIniProperty::SetValues(TArray<FString> NewValues)
+{
+	Value.Reset();
+	Values = MoveTemp(NewValues);
+}
 
 void FIniProperty::SetValueAsString(FString NewValue)
 {
-	Value = Stringfy(NewValue);
+	Values.Reset();
+	Value = MoveTemp(NewValue);
 }
 
 void FIniProperty::SetValueAsText(FText NewValue)
 {
-	Value = Stringfy(NewValue.ToString());
+	Values.Reset();
+	Value = NewValue.ToString();
 }
 
 void FIniProperty::SetValueAsName(FName NewValue)
 {
-	Value = Stringfy(UKismetStringLibrary::Conv_NameToString(NewValue));
+	Values.Reset();
+	Value = UKismetStringLibrary::Conv_NameToString(NewValue);
 }
 
 void FIniProperty::SetValueAsObject(UObject* NewValue)
 {
-	Value = Stringfy(UKismetStringLibrary::Conv_ObjectToString(NewValue));
+	Values.Reset();
+	Value = UKismetStringLibrary::Conv_ObjectToString(NewValue);
 }
 
 void FIniProperty::SetValueAsByte(uint8 NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_ByteToString(NewValue);
 }
 
 void FIniProperty::SetValueAsInt(int32 NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_IntToString(NewValue);
 }
 
 void FIniProperty::SetValueAsInt64(int64 NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_Int64ToString(NewValue);
 }
 
 void FIniProperty::SetValueAsIntPoint(FIntPoint NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_IntPointToString(NewValue);
 }
 
 void FIniProperty::SetValueAsBoolean(bool bNewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_BoolToString(bNewValue);
 }
 
 void FIniProperty::SetValueAsFloat(float NewValue)
 {
-	Value = FString::SanitizeFloat(NewValue);
+	Values.Reset();
+	Value.Reset();
+	FIniValueFormatter::AppendFloat(Value, NewValue);
 }
 
 void FIniProperty::SetValueAsDouble(double NewValue)
 {
-	Value = FString::SanitizeFloat(NewValue);
+	Values.Reset();
+	Value.Reset();
+	FIniValueFormatter::AppendDouble(Value, NewValue);
 }
 
 void FIniProperty::SetValueAsVector(FVector NewValue)
 {
-	Value = UKismetStringLibrary::Conv_VectorToString(NewValue);
+	Values.Reset();
+	const double Components[] = { NewValue.X, NewValue.Y, NewValue.Z };
+
+	Value.Reset();
+	FIniValueFormatter::AppendComponents(Value, TEXT("XYZ"), Components, UE_ARRAY_COUNT(Components));
 }
 
 void FIniProperty::SetValueAsVector2D(FVector2D NewValue)
 {
-	Value = UKismetStringLibrary::Conv_Vector2dToString(NewValue);
+	Values.Reset();
+	const double Components[] = { NewValue.X, NewValue.Y };
+
+	Value.Reset();
+	FIniValueFormatter::AppendComponents(Value, TEXT("XY"), Components, UE_ARRAY_COUNT(Components));
 }
 
 void FIniProperty::SetValueAsVector3f(FVector3f NewValue)
 {
-	Value = UKismetStringLibrary::Conv_Vector3fToString(NewValue);
+	Values.Reset();
+	const float Components[] = { NewValue.X, NewValue.Y, NewValue.Z };
+
+	Value.Reset();
+	FIniValueFormatter::AppendComponents(Value, TEXT("XYZ"), Components, UE_ARRAY_COUNT(Components));
 }
 
 void FIniProperty::SetValueAsIntVector(FIntVector NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_IntVectorToString(NewValue);
 }
 
 void FIniProperty::SetValueAsRotator(FRotator NewValue)
 {
-	Value = UKismetStringLibrary::Conv_RotatorToString(NewValue);
+	Values.Reset();
+	const double Components[] = { NewValue.Pitch, NewValue.Yaw, NewValue.Roll };
+
+	Value.Reset();
+	FIniValueFormatter::AppendComponents(Value, TEXT("PYR"), Components, UE_ARRAY_COUNT(Components));
 }
 
 void FIniProperty::SetValueAsMatrix(FMatrix NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_MatrixToString(NewValue);
 }
 
 void FIniProperty::SetValueAsTransform(FTransform NewValue)
 {
-	Value = UKismetStringLibrary::Conv_TransformToString(NewValue);
+	Values.Reset();
+	const FVector Translation = NewValue.GetTranslation();
+	const FRotator Rotation = NewValue.Rotator();
+	const FVector Scale = NewValue.GetScale3D();
+
+	const double TranslationComponents[] = { Translation.X, Translation.Y, Translation.Z };
+	const double RotationComponents[] = { Rotation.Pitch, Rotation.Yaw, Rotation.Roll };
+	const double ScaleComponents[] = { Scale.X, Scale.Y, Scale.Z };
+
+	// Same layout as UKismetStringLibrary::Conv_TransformToString, without the precision loss.
+	Value.Reset();
+	Value.Append(TEXT("Translation: "));
+	FIniValueFormatter::AppendComponents(Value, TEXT("XYZ"), TranslationComponents, UE_ARRAY_COUNT(TranslationComponents));
+	Value.Append(TEXT(" Rotation: "));
+	FIniValueFormatter::AppendComponents(Value, TEXT("PYR"), RotationComponents, UE_ARRAY_COUNT(RotationComponents));
+	Value.Append(TEXT(" Scale "));
+	FIniValueFormatter::AppendComponents(Value, TEXT("XYZ"), ScaleComponents, UE_ARRAY_COUNT(ScaleComponents));
 }
 
 void FIniProperty::SetValueAsColor(FLinearColor NewValue)
 {
-	Value = UKismetStringLibrary::Conv_ColorToString(NewValue);
+	Values.Reset();
+	const float Components[] = { NewValue.R, NewValue.G, NewValue.B, NewValue.A };
+	const TCHAR* Keys = TEXT("RGBA");
+
+	// Same layout as FLinearColor::ToString: "(R=..,G=..,B=..,A=..)"
+	Value.Reset();
+	Value.AppendChar(TEXT('('));
+
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Components); ++Index)
+	{
+		if (Index > 0)
+			Value.AppendChar(TEXT(','));
+
+		Value.AppendChar(Keys[Index]);
+		Value.AppendChar(TEXT('='));
+		FIniValueFormatter::AppendFloat(Value, Components[Index]);
+	}
+
+	Value.AppendChar(TEXT(')'));
 }
 
 void FIniProperty::SetValueAsInputDeviceId(FInputDeviceId NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_InputDeviceIdToString(NewValue);
 }
 
 void FIniProperty::SetValueAsPlatformUserId(FPlatformUserId NewValue)
 {
+	Values.Reset();
 	Value = UKismetStringLibrary::Conv_PlatformUserIdToString(NewValue);
 }
\ No newline at end of file
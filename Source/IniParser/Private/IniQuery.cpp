@@ -0,0 +1,291 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniQuery.h"
+
+namespace IniQuery
+{
+	// A plain value, or any element of an array.
+	static bool MatchesValue(const FIniProperty& Property, const FString& Value)
+	{
+		if (!Property.IsArray())
+			return Property.GetValue().Equals(Value, ESearchCase::IgnoreCase);
+
+		return Property.GetValues().ContainsByPredicate([&Value](const FString& Element)
+		{
+			return Element.Equals(Value, ESearchCase::IgnoreCase);
+		});
+	}
+}
+
+FIniQuery::FIniQuery(const FIniData& Data, EIniQueryIndex InIndexes)
+	: Indexes(InIndexes)
+{
+	// Results name properties by FName, which can not hold a case-sensitive key.
+	if (!ensureMsgf(!Data.HasKeyedProperties(), TEXT("FIniQuery does not support case-sensitive keys, nothing is indexed")))
+	{
+		Indexes = EIniQueryIndex::None;
+		return;
+	}
+
+	const TMap<FName, FIniSection>& Sections = Data.GetSections();
+
+	int32 NumEntries = Data.GetNumOfProperties();
+
+	for (const auto& SectionPair : Sections)
+		NumEntries += SectionPair.Value.GetNumOfProperties();
+
+	Entries.Reserve(NumEntries);
+
+	for (const auto& PropertyPair : Data.GetProperties())
+		AddEntry(NAME_None, PropertyPair.Key, PropertyPair.Value);
+
+	for (const auto& SectionPair : Sections)
+	{
+		for (const auto& PropertyPair : SectionPair.Value.GetProperties())
+			AddEntry(SectionPair.Key, PropertyPair.Key, PropertyPair.Value);
+	}
+
+	if (EnumHasAnyFlags(Indexes, EIniQueryIndex::Values))
+	{
+		ValueIndex.Reserve(Entries.Num());
+
+		for (int32 Index = 0; Index < Entries.Num(); Index++)
+		{
+			const FIniProperty& Property = *Entries[Index].Value;
+
+			if (!Property.IsArray())
+			{
+				ValueIndex.FindOrAdd(Property.GetValue()).Add(Index);
+				continue;
+			}
+
+			// Every element finds its property, once.
+			for (const FString& Element : Property.GetValues())
+			{
+				TArray<int32>& ValueEntries = ValueIndex.FindOrAdd(Element);
+
+				if (ValueEntries.IsEmpty() || ValueEntries.Last() != Index)
+					ValueEntries.Add(Index);
+			}
+		}
+	}
+
+	if (EnumHasAnyFlags(Indexes, EIniQueryIndex::Keys))
+	{
+		Trie.AddDefaulted();
+
+		for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); KeyIndex++)
+			InsertKey(KeyIndex);
+	}
+}
+
+void FIniQuery::AddEntry(const FName& Section, const FName& Property, const FIniProperty& Value)
+{
+	const int32 EntryIndex = Entries.Add({ Section, Property, &Value });
+
+	int32& KeyIndex = KeyLookup.FindOrAdd(Property, INDEX_NONE);
+
+	if (KeyIndex == INDEX_NONE)
+		KeyIndex = Keys.Add({ Property, {} });
+
+	Keys[KeyIndex].Entries.Add(EntryIndex);
+}
+
+void FIniQuery::InsertKey(int32 KeyIndex)
+{
+	TStringBuilder<128> Name;
+	Keys[KeyIndex].Name.AppendString(Name);
+
+	int32 Node = 0;
+
+	for (TCHAR Char : Name.ToView())
+	{
+		Char = FChar::ToLower(Char);
+
+		int32 Child = Trie[Node].FirstChild;
+
+		while (Child != INDEX_NONE && Trie[Child].Char != Char)
+			Child = Trie[Child].NextSibling;
+
+		if (Child == INDEX_NONE)
+		{
+			Child = Trie.AddDefaulted();
+			Trie[Child].Char = Char;
+			Trie[Child].NextSibling = Trie[Node].FirstChild;
+			Trie[Node].FirstChild = Child;
+		}
+
+		Node = Child;
+	}
+
+	Trie[Node].Key = KeyIndex;
+}
+
+int32 FIniQuery::FindNode(const TCHAR* Prefix, int32 Len) const
+{
+	int32 Node = 0;
+
+	for (int32 Index = 0; Index < Len && Node != INDEX_NONE; Index++)
+	{
+		const TCHAR Char = FChar::ToLower(Prefix[Index]);
+
+		Node = Trie[Node].FirstChild;
+
+		while (Node != INDEX_NONE && Trie[Node].Char != Char)
+			Node = Trie[Node].NextSibling;
+	}
+
+	return Node;
+}
+
+void FIniQuery::AppendKey(int32 KeyIndex, TArray<FIniQueryResult>& OutResults) const
+{
+	for (int32 EntryIndex : Keys[KeyIndex].Entries)
+		OutResults.Add(Entries[EntryIndex]);
+}
+
+void FIniQuery::CollectKeys(int32 Node, const FString* Pattern, TArray<FIniQueryResult>& OutResults) const
+{
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(Node);
+
+	while (Stack.Num() > 0)
+	{
+		const FTrieNode& Current = Trie[Stack.Pop(false)];
+
+		if (Current.Key != INDEX_NONE && (!Pattern || Keys[Current.Key].Name.ToString().MatchesWildcard(*Pattern)))
+			AppendKey(Current.Key, OutResults);
+
+		for (int32 Child = Current.FirstChild; Child != INDEX_NONE; Child = Trie[Child].NextSibling)
+			Stack.Add(Child);
+	}
+}
+
+void FIniQuery::FindByValue(const FString& Value, TArray<FIniQueryResult>& OutResults) const
+{
+	if (EnumHasAnyFlags(Indexes, EIniQueryIndex::Values))
+	{
+		if (const TArray<int32>* Found = ValueIndex.Find(Value))
+		{
+			for (int32 EntryIndex : *Found)
+				OutResults.Add(Entries[EntryIndex]);
+		}
+
+		return;
+	}
+
+	for (const FIniQueryResult& Entry : Entries)
+	{
+		if (IniQuery::MatchesValue(*Entry.Value, Value))
+			OutResults.Add(Entry);
+	}
+}
+
+void FIniQuery::FindByValue(const FName& Key, const FString& Value, TArray<FIniQueryResult>& OutResults) const
+{
+	const int32* KeyIndex = KeyLookup.Find(Key);
+
+	if (!KeyIndex)
+		return;
+
+	const TArray<int32>& KeyEntries = Keys[*KeyIndex].Entries;
+	const TArray<int32>* ValueEntries = ValueIndex.Find(Value);
+
+	// Walk whichever list is shorter.
+	if (ValueEntries && ValueEntries->Num() < KeyEntries.Num())
+	{
+		for (int32 EntryIndex : *ValueEntries)
+		{
+			if (Entries[EntryIndex].Property == Key)
+				OutResults.Add(Entries[EntryIndex]);
+		}
+
+		return;
+	}
+
+	if (!ValueEntries && EnumHasAnyFlags(Indexes, EIniQueryIndex::Values))
+		return;
+
+	for (int32 EntryIndex : KeyEntries)
+	{
+		if (IniQuery::MatchesValue(*Entries[EntryIndex].Value, Value))
+			OutResults.Add(Entries[EntryIndex]);
+	}
+}
+
+void FIniQuery::FindByKeyPrefix(const FString& Prefix, TArray<FIniQueryResult>& OutResults) const
+{
+	if (!EnumHasAnyFlags(Indexes, EIniQueryIndex::Keys))
+	{
+		for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); KeyIndex++)
+		{
+			if (Keys[KeyIndex].Name.ToString().StartsWith(Prefix, ESearchCase::IgnoreCase))
+				AppendKey(KeyIndex, OutResults);
+		}
+
+		return;
+	}
+
+	const int32 Node = FindNode(*Prefix, Prefix.Len());
+
+	if (Node != INDEX_NONE)
+		CollectKeys(Node, nullptr, OutResults);
+}
+
+void FIniQuery::FindByKeyWildcard(const FString& Pattern, TArray<FIniQueryResult>& OutResults) const
+{
+	int32 PrefixLen = 0;
+
+	while (PrefixLen < Pattern.Len() && Pattern[PrefixLen] != TEXT('*') && Pattern[PrefixLen] != TEXT('?'))
+		PrefixLen++;
+
+	if (!EnumHasAnyFlags(Indexes, EIniQueryIndex::Keys))
+	{
+		for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); KeyIndex++)
+		{
+			if (Keys[KeyIndex].Name.ToString().MatchesWildcard(Pattern))
+				AppendKey(KeyIndex, OutResults);
+		}
+
+		return;
+	}
+
+	const int32 Node = FindNode(*Pattern, PrefixLen);
+
+	if (Node == INDEX_NONE)
+		return;
+
+	// A pattern that is only a prefix followed by '*' needs no matching at all.
+	const bool bPrefixOnly = PrefixLen == Pattern.Len() - 1 && Pattern[PrefixLen] == TEXT('*');
+
+	if (PrefixLen == Pattern.Len())
+	{
+		if (Trie[Node].Key != INDEX_NONE)
+			AppendKey(Trie[Node].Key, OutResults);
+	}
+	else
+	{
+		CollectKeys(Node, bPrefixOnly ? nullptr : &Pattern, OutResults);
+	}
+}
+
+void FIniQuery::FindBySection(const FString& SectionPattern, TArray<FIniQueryResult>& OutResults) const
+{
+	FName LastSection = NAME_None;
+	bool bLastMatched = false;
+	bool bFirst = true;
+
+	// Entries of one section are contiguous, so each section name is matched once.
+	for (const FIniQueryResult& Entry : Entries)
+	{
+		if (bFirst || Entry.Section != LastSection)
+		{
+			LastSection = Entry.Section;
+			bLastMatched = !LastSection.IsNone() && LastSection.ToString().MatchesWildcard(SectionPattern);
+			bFirst = false;
+		}
+
+		if (bLastMatched)
+			OutResults.Add(Entry);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniReadTelemetry.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+
+namespace IniReadTelemetry
+{
+	struct FKey
+	{
+		FName Section;
+		FName Property;
+
+		FORCEINLINE bool operator==(const FKey& Other) const { return Section == Other.Section && Property == Other.Property; }
+
+		friend FORCEINLINE uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Section), GetTypeHash(Key.Property));
+		}
+	};
+
+	/* One lock and one map per shard; a thread always lands on the same shard */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		FCriticalSection Lock;
+		TMap<FKey, uint64> Counts;
+	};
+
+	static constexpr int32 NUM_SHARDS = 16;
+	static FShard Shards[NUM_SHARDS];
+
+	static FORCEINLINE FShard& GetShard()
+	{
+		return Shards[FPlatformTLS::GetCurrentThreadId() % NUM_SHARDS];
+	}
+
+	/* Sum every shard into one map */
+	static TMap<FKey, uint64> Merge()
+	{
+		TMap<FKey, uint64> Merged;
+
+		for (FShard& Shard : Shards)
+		{
+			FScopeLock Lock(&Shard.Lock);
+
+			for (const auto& Pair : Shard.Counts)
+				Merged.FindOrAdd(Pair.Key) += Pair.Value;
+		}
+
+		return Merged;
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("IniParser.ReadTelemetry.Dump"),
+		TEXT("Print the most read ini keys. Optional argument: number of keys (default 50)."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld*, FOutputDevice& Output)
+		{
+			FIniReadTelemetry::Dump(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50, Output);
+		}));
+
+	static FAutoConsoleCommand EnableCommand(
+		TEXT("IniParser.ReadTelemetry.Enable"),
+		TEXT("Start (1) or stop (0) counting ini key reads."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FIniReadTelemetry::SetEnabled(Args.Num() == 0 || FCString::ToBool(*Args[0]));
+		}));
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("IniParser.ReadTelemetry.Reset"),
+		TEXT("Clear the ini key read counts."),
+		FConsoleCommandDelegate::CreateStatic(&FIniReadTelemetry::Reset));
+}
+
+const FName FIniReadTelemetry::ANY_SECTION(TEXT("*"));
+
+std::atomic<bool> FIniReadTelemetry::bEnabled(false);
+
+void FIniReadTelemetry::SetEnabled(bool bNewEnabled)
+{
+	bEnabled.store(bNewEnabled, std::memory_order_relaxed);
+}
+
+void FIniReadTelemetry::RecordReadSlow(const FName& Section, const FName& Property)
+{
+	IniReadTelemetry::FShard& Shard = IniReadTelemetry::GetShard();
+
+	FScopeLock Lock(&Shard.Lock);
+	Shard.Counts.FindOrAdd({ Section, Property })++;
+}
+
+TArray<FIniKeyReadCount> FIniReadTelemetry::GetHottestKeys(int32 MaxNum)
+{
+	TMap<IniReadTelemetry::FKey, uint64> Merged = IniReadTelemetry::Merge();
+
+	TArray<FIniKeyReadCount> Result;
+	Result.Reserve(Merged.Num());
+
+	for (const auto& Pair : Merged)
+		Result.Add({ Pair.Key.Section, Pair.Key.Property, Pair.Value });
+
+	Result.Sort([](const FIniKeyReadCount& A, const FIniKeyReadCount& B)
+	{
+		return A.NumReads > B.NumReads;
+	});
+
+	if (MaxNum >= 0 && Result.Num() > MaxNum)
+		Result.SetNum(MaxNum);
+
+	return Result;
+}
+
+TArray<FIniKeyReadCount> FIniReadTelemetry::GetUnreadKeys(const FIniData& Data)
+{
+	TMap<IniReadTelemetry::FKey, uint64> Merged = IniReadTelemetry::Merge();
+	TArray<FIniKeyReadCount> Result;
+
+	auto IsRead = [&Merged](const FName& Section, const FName& Property)
+	{
+		return Merged.Contains({ Section, Property }) || (!Section.IsNone() && Merged.Contains({ ANY_SECTION, Property }));
+	};
+
+	for (const auto& PropertyPair : Data.GetProperties())
+	{
+		if (!IsRead(NAME_None, PropertyPair.Key))
+			Result.Add({ NAME_None, PropertyPair.Key, 0 });
+	}
+
+	for (const auto& SectionPair : Data.GetSections())
+	{
+		for (const auto& PropertyPair : SectionPair.Value.GetProperties())
+		{
+			if (!IsRead(SectionPair.Key, PropertyPair.Key))
+				Result.Add({ SectionPair.Key, PropertyPair.Key, 0 });
+		}
+	}
+
+	return Result;
+}
+
+void FIniReadTelemetry::Reset()
+{
+	for (IniReadTelemetry::FShard& Shard : IniReadTelemetry::Shards)
+	{
+		FScopeLock Lock(&Shard.Lock);
+		Shard.Counts.Reset();
+	}
+}
+
+void FIniReadTelemetry::Dump(int32 MaxNum, FOutputDevice& Output)
+{
+	const TArray<FIniKeyReadCount> Hottest = GetHottestKeys(MaxNum);
+
+	Output.Logf(TEXT("IniParser read telemetry (%s, %d keys)"), IsEnabled() ? TEXT("enabled") : TEXT("disabled"), Hottest.Num());
+
+	for (const FIniKeyReadCount& Count : Hottest)
+		Output.Logf(TEXT("%12llu  [%s] %s"), Count.NumReads, *Count.Section.ToString(), *Count.Property.ToString());
+}
\ No newline at end of file
@@ -0,0 +1,335 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniSchema.h"
+
+#include "IniValueParser.h"
+
+namespace IniSchema
+{
+	static const FName REQUIRED_OPTION(TEXT(".required"));
+	static const FName UNKNOWN_OPTION(TEXT(".unknown"));
+
+	static FORCEINLINE bool IsPattern(const FString& Name)
+	{
+		int32 Index;
+		return Name.FindChar(TEXT('*'), Index) || Name.FindChar(TEXT('?'), Index);
+	}
+
+	static bool IsBool(const FString& Value)
+	{
+		return Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("false"), ESearchCase::IgnoreCase)
+			|| Value.Equals(TEXT("yes"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("no"), ESearchCase::IgnoreCase)
+			|| Value == TEXT("1") || Value == TEXT("0");
+	}
+}
+
+FIniSchema FIniSchema::Compile(const FIniData& SchemaData, TArray<FString>& OutErrors)
+{
+	FIniSchema Schema;
+
+	// Rules are looked up by FName, which can not hold a case-sensitive key.
+	if (SchemaData.HasKeyedProperties())
+	{
+		OutErrors.Add(TEXT("Schemas with case-sensitive keys are not supported, no rule is compiled"));
+		return Schema;
+	}
+
+	CompileSection(SchemaData.GetProperties(), Schema.GlobalValidator, OutErrors);
+
+	for (const auto& SectionPair : SchemaData.GetSections())
+	{
+		const FString Name = SectionPair.Key.ToString();
+
+		FSectionValidator Validator;
+		Validator.Pattern = Name;
+		CompileSection(SectionPair.Value.GetProperties(), Validator, OutErrors);
+
+		if (IniSchema::IsPattern(Name))
+		{
+			if (Validator.bRequired)
+				OutErrors.Add(FString::Printf(TEXT("[%s] .required has no effect on wildcard sections"), *Name));
+
+			Schema.PatternValidators.Add(MoveTemp(Validator));
+		}
+		else
+		{
+			Schema.SectionValidators.Add(SectionPair.Key, MoveTemp(Validator));
+		}
+	}
+
+	return Schema;
+}
+
+void FIniSchema::CompileSection(const TMap<FName, FIniProperty>& Properties, FSectionValidator& OutValidator, TArray<FString>& OutErrors)
+{
+	OutValidator.Rules.Reserve(Properties.Num());
+
+	for (const auto& PropertyPair : Properties)
+	{
+		const FString& Spec = PropertyPair.Value.GetValue();
+
+		if (PropertyPair.Key == IniSchema::REQUIRED_OPTION)
+		{
+			OutValidator.bRequired = Spec.ToBool();
+			continue;
+		}
+
+		if (PropertyPair.Key == IniSchema::UNKNOWN_OPTION)
+		{
+			OutValidator.bDenyUnknown = Spec.Equals(TEXT("deny"), ESearchCase::IgnoreCase);
+			continue;
+		}
+
+		TArray<FString> Tokens;
+		Spec.ParseIntoArray(Tokens, TEXT(","));
+
+		for (FString& Token : Tokens)
+			Token.TrimStartAndEndInline();
+
+		FRule Rule;
+		Rule.Key = PropertyPair.Key;
+
+		static const TPair<const TCHAR*, EType> TYPES[] =
+		{
+			{ TEXT("string"), EType::String },
+			{ TEXT("name"), EType::Name },
+			{ TEXT("int"), EType::Int },
+			{ TEXT("float"), EType::Float },
+			{ TEXT("bool"), EType::Bool },
+			{ TEXT("vector"), EType::Vector },
+			{ TEXT("rotator"), EType::Rotator },
+			{ TEXT("color"), EType::Color },
+		};
+
+		bool bTypeFound = false;
+
+		for (const TPair<const TCHAR*, EType>& Type : TYPES)
+		{
+			if (Tokens.Num() > 0 && Tokens[0].Equals(Type.Key, ESearchCase::IgnoreCase))
+			{
+				Rule.Type = Type.Value;
+				bTypeFound = true;
+				break;
+			}
+		}
+
+		if (!bTypeFound)
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: unknown type in '%s'"), *PropertyPair.Key.ToString(), *Spec));
+			continue;
+		}
+
+		bool bValid = true;
+
+		for (int32 Index = 1; Index < Tokens.Num() && bValid; Index++)
+		{
+			const FString& Token = Tokens[Index];
+
+			if (Token.Equals(TEXT("required"), ESearchCase::IgnoreCase))
+				Rule.bRequired = true;
+			else if (Token.StartsWith(TEXT("min="), ESearchCase::IgnoreCase))
+				bValid = Rule.bHasMin = FIniValueParser::ParseDouble(Token.RightChop(4), Rule.Min);
+			else if (Token.StartsWith(TEXT("max="), ESearchCase::IgnoreCase))
+				bValid = Rule.bHasMax = FIniValueParser::ParseDouble(Token.RightChop(4), Rule.Max);
+			else if (Token.StartsWith(TEXT("values="), ESearchCase::IgnoreCase))
+				Token.RightChop(7).ParseIntoArray(Rule.AllowedValues, TEXT("|"));
+			else
+				bValid = false;
+		}
+
+		if (!bValid)
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: can not parse '%s'"), *PropertyPair.Key.ToString(), *Spec));
+			continue;
+		}
+
+		OutValidator.RuleIndex.Add(Rule.Key, OutValidator.Rules.Num());
+		OutValidator.Rules.Add(MoveTemp(Rule));
+	}
+}
+
+const FIniSchema::FSectionValidator* FIniSchema::FindValidator(const FName& SectionName) const
+{
+	if (const FSectionValidator* Validator = SectionValidators.Find(SectionName))
+		return Validator;
+
+	if (PatternValidators.IsEmpty())
+		return nullptr;
+
+	const FString Name = SectionName.ToString();
+
+	for (const FSectionValidator& Validator : PatternValidators)
+	{
+		if (Name.MatchesWildcard(Validator.Pattern))
+			return &Validator;
+	}
+
+	return nullptr;
+}
+
+bool FIniSchema::Validate(const FIniData& Data, TArray<FIniSchemaViolation>& OutViolations) const
+{
+	const int32 NumViolations = OutViolations.Num();
+
+	if (Data.HasKeyedProperties())
+	{
+		OutViolations.Emplace(NAME_None, NAME_None, TEXT("Documents with case-sensitive keys can not be validated"));
+		return false;
+	}
+
+	ValidateProperties(GlobalValidator, NAME_None, Data.GetProperties(), OutViolations);
+
+	for (const auto& SectionPair : Data.GetSections())
+	{
+		if (const FSectionValidator* Validator = FindValidator(SectionPair.Key))
+			ValidateProperties(*Validator, SectionPair.Key, SectionPair.Value.GetProperties(), OutViolations);
+	}
+
+	for (const auto& ValidatorPair : SectionValidators)
+	{
+		if (ValidatorPair.Value.bRequired && !Data.HasSection(ValidatorPair.Key))
+			OutViolations.Emplace(ValidatorPair.Key, NAME_None, TEXT("Missing required section"));
+	}
+
+	return OutViolations.Num() == NumViolations;
+}
+
+void FIniSchema::ValidateProperties(const FSectionValidator& Validator, const FName& SectionName, const TMap<FName, FIniProperty>& Properties, TArray<FIniSchemaViolation>& OutViolations)
+{
+	if (Validator.Rules.IsEmpty() && !Validator.bDenyUnknown)
+		return;
+
+	TBitArray<TInlineAllocator<4>> Seen(false, Validator.Rules.Num());
+
+	for (const auto& PropertyPair : Properties)
+	{
+		const int32* RuleIndex = Validator.RuleIndex.Find(PropertyPair.Key);
+
+		if (!RuleIndex)
+		{
+			if (Validator.bDenyUnknown)
+				OutViolations.Emplace(SectionName, PropertyPair.Key, TEXT("Unknown key"));
+
+			continue;
+		}
+
+		Seen[*RuleIndex] = true;
+
+		const FRule& Rule = Validator.Rules[*RuleIndex];
+
+		if (!PropertyPair.Value.IsArray())
+		{
+			FString Error = CheckValue(Rule, PropertyPair.Value.GetValue());
+
+			if (!Error.IsEmpty())
+				OutViolations.Emplace(SectionName, PropertyPair.Key, MoveTemp(Error));
+
+			continue;
+		}
+
+		// Every element of an array follows the rule.
+		for (const FString& Element : PropertyPair.Value.GetValues())
+		{
+			FString Error = CheckValue(Rule, Element);
+
+			if (!Error.IsEmpty())
+				OutViolations.Emplace(SectionName, PropertyPair.Key, MoveTemp(Error));
+		}
+	}
+
+	for (int32 Index = 0; Index < Validator.Rules.Num(); Index++)
+	{
+		if (Validator.Rules[Index].bRequired && !Seen[Index])
+			OutViolations.Emplace(SectionName, Validator.Rules[Index].Key, TEXT("Missing required key"));
+	}
+}
+
+FString FIniSchema::CheckValue(const FRule& Rule, const FString& Value)
+{
+	double Number = 0.0;
+	bool bNumeric = false;
+
+	switch (Rule.Type)
+	{
+		case EType::String:
+		case EType::Name:
+			Number = Value.Len();
+			bNumeric = true;
+			break;
+
+		case EType::Int:
+		{
+			int64 Integer;
+
+			if (!FIniValueParser::ParseInt64(Value, Integer))
+				return FString::Printf(TEXT("'%s' is not an integer"), *Value);
+
+			Number = static_cast<double>(Integer);
+			bNumeric = true;
+			break;
+		}
+
+		case EType::Float:
+			if (!FIniValueParser::ParseDouble(Value, Number))
+				return FString::Printf(TEXT("'%s' is not a number"), *Value);
+
+			bNumeric = true;
+			break;
+
+		case EType::Bool:
+			if (!IniSchema::IsBool(Value))
+				return FString::Printf(TEXT("'%s' is not a boolean"), *Value);
+			break;
+
+		case EType::Vector:
+		{
+			FVector Vector;
+
+			if (!FIniValueParser::ParseVector(Value, Vector))
+				return FString::Printf(TEXT("'%s' is not a vector"), *Value);
+			break;
+		}
+
+		case EType::Rotator:
+		{
+			FRotator Rotator;
+
+			if (!FIniValueParser::ParseRotator(Value, Rotator))
+				return FString::Printf(TEXT("'%s' is not a rotator"), *Value);
+			break;
+		}
+
+		case EType::Color:
+		{
+			FLinearColor Color;
+
+			if (!FIniValueParser::ParseColor(Value, Color))
+				return FString::Printf(TEXT("'%s' is not a color"), *Value);
+			break;
+		}
+	}
+
+	if (bNumeric)
+	{
+		const TCHAR* What = Rule.Type == EType::String || Rule.Type == EType::Name ? TEXT("Length") : TEXT("Value");
+
+		if (Rule.bHasMin && Number < Rule.Min)
+			return FString::Printf(TEXT("%s %g is below the minimum %g"), What, Number, Rule.Min);
+
+		if (Rule.bHasMax && Number > Rule.Max)
+			return FString::Printf(TEXT("%s %g is above the maximum %g"), What, Number, Rule.Max);
+	}
+
+	if (Rule.AllowedValues.Num() > 0)
+	{
+		const bool bAllowed = Rule.AllowedValues.ContainsByPredicate([&Value](const FString& Allowed)
+		{
+			return Allowed.Equals(Value, ESearchCase::IgnoreCase);
+		});
+
+		if (!bAllowed)
+			return FString::Printf(TEXT("'%s' is not one of the allowed values"), *Value);
+	}
+
+	return FString();
+}
\ No newline at end of file
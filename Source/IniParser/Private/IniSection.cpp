@@ -1,15 +1,45 @@
 // Copyright 2023 MrRobin. All Rights Reserved.
 
 #include "IniSection.h"
+#include "IniReadTelemetry.h"
+
+void FIniSection::Reserve(int32 NumProperties, int32 NumComments, EIniKeyMode KeyMode)
+{
+	if (KeyMode == EIniKeyMode::CaseSensitive)
+		KeyedProperties.Reserve(NumProperties);
+	else
+		Properties.Reserve(NumProperties);
+
+	Comments.Reserve(NumComments);
+}
 
 void FIniSection::AddComment(FString Comment)
 {
-	Comments.Add(Comment);
+	Comments.Add(MoveTemp(Comment));
 }
 
 void FIniSection::AddUniqueComment(FString Comment)
 {
-	Comments.AddUnique(Comment);
+	Comments.AddUnique(MoveTemp(Comment));
+}
+
+bool FIniSection::RemoveComment(const FString& Comment)
+{
+	const int32 Index = Comments.IndexOfByPredicate([&Comment](const FString& Existing)
+	{
+		return Existing.Equals(Comment, ESearchCase::CaseSensitive);
+	});
+
+	if (Index == INDEX_NONE)
+		return false;
+
+	Comments.RemoveAt(Index);
+	return true;
+}
+
+bool FIniSection::RemoveProperty(const FName& PropertyName)
+{
+	return Properties.Remove(PropertyName) > 0;
 }
 
 FIniProperty& FIniSection::GetProperty(const FName& PropertyName)
@@ -19,9 +49,36 @@ FIniProperty& FIniSection::GetProperty(const FName& PropertyName)
 
 FIniProperty* FIniSection::FindProperty(const FName& Key)
 {
+	FIniReadTelemetry::RecordRead(FIniReadTelemetry::ANY_SECTION, Key);
+
 	return Properties.Find(Key);
 }
 
+FIniProperty* FIniSection::FindPropertyByString(FStringView Key)
+{
+	if (FIniProperty* Property = KeyedProperties.IsEmpty() ? nullptr : KeyedProperties.Find(Key))
+		return Property;
+
+	// FNAME_Find never adds to the name table; a key that was never interned is not among the FName properties either.
+	const FName Name(Key.Len(), Key.GetData(), FNAME_Find);
+
+	// NAME_None means the lookup failed, unless the key is "None" itself.
+	if (Name.IsNone() && !Key.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+		return nullptr;
+
+	return Properties.Find(Name);
+}
+
+FIniProperty& FIniSection::FindOrAddKeyedProperty(FStringView Key, FString&& Value)
+{
+	return KeyedProperties.FindOrAdd(Key, MoveTemp(Value));
+}
+
+bool FIniSection::RemoveKeyedProperty(FStringView Key)
+{
+	return KeyedProperties.Remove(Key);
+}
+
 FIniProperty FIniSection::FindRefProperty(const FName& Key)
 {
 	return Properties.FindRef(Key);
@@ -29,7 +86,18 @@ FIniProperty FIniSection::FindRefProperty(const FName& Key)
 
 FIniProperty& FIniSection::FindOrAddProperty(const FName& Key, const FString& Value)
 {
-	return Properties.FindOrAdd(Key, FIniProperty(Value));
+	if (FIniProperty* Property = Properties.Find(Key))
+		return *Property;
+
+	return Properties.Add(Key, FIniProperty(Value));
+}
+
+FIniProperty& FIniSection::FindOrAddProperty(const FName& Key, FString&& Value)
+{
+	if (FIniProperty* Property = Properties.Find(Key))
+		return *Property;
+
+	return Properties.Add(Key, FIniProperty(MoveTemp(Value)));
 }
 
 FIniProperty& FIniSection::AddProperty(const FName& Key, const FString& Value)
@@ -37,6 +105,26 @@ FIniProperty& FIniSection::AddProperty(const FName& Key, const FString& Value)
 	return Properties.Add(Key, FIniProperty(Value));
 }
 
+FIniProperty& FIniSection::AddProperty(const FName& Key, FString&& Value)
+{
+	return Properties.Add(Key, FIniProperty(MoveTemp(Value)));
+}
+
+FIniProperty& FIniSection::AddProperty(const FName& Key, FIniProperty&& Property)
+{
+	return Properties.Add(Key, MoveTemp(Property));
+}
+
+TMap<FName, FIniProperty> FIniSection::ExtractProperties()
+{
+	return MoveTemp(Properties);
+}
+
+TArray<FString> FIniSection::ExtractComments()
+{
+	return MoveTemp(Comments);
+}
+
 FIniProperty& FIniSection::operator[](const FName& PropertyName)
 {
 	return Properties[PropertyName];
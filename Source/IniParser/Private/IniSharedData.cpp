@@ -0,0 +1,143 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniSharedData.h"
+
+FIniSharedData::FIniSharedData()
+	: Document(MakeShared<FDocument, ESPMode::ThreadSafe>())
+{ }
+
+FIniSharedData::FIniSharedData(FIniData&& Data)
+	: Document(MakeShared<FDocument, ESPMode::ThreadSafe>())
+{
+	TMap<FName, FIniSection> Sections = Data.ExtractSections();
+	Document->Sections.Reserve(Sections.Num());
+
+	for (auto& SectionPair : Sections)
+		Document->Sections.Add(SectionPair.Key, MakeShared<FIniSection, ESPMode::ThreadSafe>(MoveTemp(SectionPair.Value)));
+
+	Document->Globals->Properties = Data.ExtractProperties();
+	Document->Globals->KeyedProperties = MoveTemp(Data.GetKeyedProperties());
+	Document->Globals->Comments = Data.ExtractComments();
+	Document->Globals->KeyMode = Data.GetKeyMode();
+}
+
+FIniSharedData::FIniSharedData(const FIniData& Data)
+	: Document(MakeShared<FDocument, ESPMode::ThreadSafe>())
+{
+	Document->Sections.Reserve(Data.GetNumOfSections());
+
+	for (const auto& SectionPair : Data.GetSections())
+		Document->Sections.Add(SectionPair.Key, MakeShared<FIniSection, ESPMode::ThreadSafe>(SectionPair.Value));
+
+	Document->Globals->Properties = Data.GetProperties();
+	Document->Globals->KeyedProperties = Data.GetKeyedProperties();
+	Document->Globals->Comments = Data.GetComments();
+	Document->Globals->KeyMode = Data.GetKeyMode();
+}
+
+const FIniSection* FIniSharedData::FindSection(const FName& Key) const
+{
+	const FSectionRef* Section = Document->Sections.Find(Key);
+	return Section ? &Section->Get() : nullptr;
+}
+
+const FIniProperty* FIniSharedData::FindProperty(const FName& Key) const
+{
+	return Document->Globals->Properties.Find(Key);
+}
+
+const FIniProperty* FIniSharedData::FindPropertyByString(FStringView Key) const
+{
+	if (const FIniProperty* Property = Document->Globals->KeyedProperties.IsEmpty() ? nullptr : Document->Globals->KeyedProperties.Find(Key))
+		return Property;
+
+	const FName Name(Key.Len(), Key.GetData(), FNAME_Find);
+
+	// NAME_None means the lookup failed, unless the key is "None" itself.
+	if (Name.IsNone() && !Key.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+		return nullptr;
+
+	return Document->Globals->Properties.Find(Name);
+}
+
+FIniSection* FIniSharedData::FindSectionForEdit(const FName& Key)
+{
+	if (!Document->Sections.Contains(Key))
+		return nullptr;
+
+	return &MutableSection(MutableDocument().Sections[Key]);
+}
+
+FIniSection& FIniSharedData::FindOrAddSectionForEdit(const FName& Key)
+{
+	FDocument& Mutable = MutableDocument();
+
+	if (FSectionRef* Section = Mutable.Sections.Find(Key))
+		return MutableSection(*Section);
+
+	return Mutable.Sections.Add(Key, MakeShared<FIniSection, ESPMode::ThreadSafe>()).Get();
+}
+
+bool FIniSharedData::RemoveSection(const FName& Key)
+{
+	if (!Document->Sections.Contains(Key))
+		return false;
+
+	return MutableDocument().Sections.Remove(Key) > 0;
+}
+
+TMap<FName, FIniProperty>& FIniSharedData::EditProperties()
+{
+	return MutableGlobals().Properties;
+}
+
+FIniKeyTable& FIniSharedData::EditKeyedProperties()
+{
+	return MutableGlobals().KeyedProperties;
+}
+
+TArray<FString>& FIniSharedData::EditComments()
+{
+	return MutableGlobals().Comments;
+}
+
+FIniData FIniSharedData::ToIniData() const
+{
+	TMap<FName, FIniSection> Sections;
+	Sections.Reserve(Document->Sections.Num());
+
+	for (const auto& SectionPair : Document->Sections)
+		Sections.Add(SectionPair.Key, SectionPair.Value.Get());
+
+	FIniData Data(MoveTemp(Sections), Document->Globals->Properties, Document->Globals->Comments);
+	Data.SetKeyMode(Document->Globals->KeyMode);
+	Data.GetKeyedProperties() = Document->Globals->KeyedProperties;
+
+	return Data;
+}
+
+FIniSharedData::FDocument& FIniSharedData::MutableDocument()
+{
+	if (!Document.IsUnique())
+		Document = MakeShared<FDocument, ESPMode::ThreadSafe>(Document.Get());
+
+	return Document.Get();
+}
+
+FIniSection& FIniSharedData::MutableSection(FSectionRef& Section)
+{
+	if (!Section.IsUnique())
+		Section = MakeShared<FIniSection, ESPMode::ThreadSafe>(Section.Get());
+
+	return Section.Get();
+}
+
+FIniSharedData::FGlobals& FIniSharedData::MutableGlobals()
+{
+	FDocument& Mutable = MutableDocument();
+
+	if (!Mutable.Globals.IsUnique())
+		Mutable.Globals = MakeShared<FGlobals, ESPMode::ThreadSafe>(Mutable.Globals.Get());
+
+	return Mutable.Globals.Get();
+}
\ No newline at end of file
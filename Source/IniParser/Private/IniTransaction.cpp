@@ -0,0 +1,130 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniTransaction.h"
+#include "IniConcurrentStore.h"
+#include "Async/Async.h"
+
+namespace IniTransaction
+{
+	/* Property and comment edits target the global scope when no section is named */
+	template <typename ValueType>
+	static FORCEINLINE FIniPatchEntry MakeEntry(EIniPatchOperation Operation, const FName& SectionName, const FName& Key, ValueType&& Value)
+	{
+		return SectionName.IsNone()
+			? FIniPatchEntry(Operation, Key, Forward<ValueType>(Value))
+			: FIniPatchEntry(Operation, SectionName, Key, Forward<ValueType>(Value));
+	}
+}
+
+void FIniTransaction::SetProperty(const FName& SectionName, const FName& PropertyName, FString Value)
+{
+	Edits.Add(IniTransaction::MakeEntry(EIniPatchOperation::SetProperty, SectionName, PropertyName, MoveTemp(Value)));
+}
+
+void FIniTransaction::SetProperty(const FName& SectionName, const FName& PropertyName, const FIniProperty& Property)
+{
+	Edits.Add(IniTransaction::MakeEntry(EIniPatchOperation::SetProperty, SectionName, PropertyName, Property));
+}
+
+void FIniTransaction::RemoveProperty(const FName& SectionName, const FName& PropertyName)
+{
+	Edits.Add(IniTransaction::MakeEntry(EIniPatchOperation::RemoveProperty, SectionName, PropertyName, FString()));
+}
+
+void FIniTransaction::AddSection(const FName& SectionName)
+{
+	Edits.Emplace(EIniPatchOperation::AddSection, SectionName, NAME_None, FString());
+}
+
+void FIniTransaction::RemoveSection(const FName& SectionName)
+{
+	Edits.Emplace(EIniPatchOperation::RemoveSection, SectionName, NAME_None, FString());
+}
+
+void FIniTransaction::AddComment(const FName& SectionName, FString Comment)
+{
+	Edits.Add(IniTransaction::MakeEntry(EIniPatchOperation::AddComment, SectionName, NAME_None, MoveTemp(Comment)));
+}
+
+void FIniTransaction::RemoveComment(const FName& SectionName, FString Comment)
+{
+	Edits.Add(IniTransaction::MakeEntry(EIniPatchOperation::RemoveComment, SectionName, NAME_None, MoveTemp(Comment)));
+}
+
+void FIniTransaction::Reset()
+{
+	Edits.Reset();
+}
+
+FIniPatch FIniTransaction::Commit(FIniData& Data)
+{
+	FIniPatch Patch = BuildPatch();
+
+	if (Patch.IsEmpty())
+		return Patch;
+
+	if (!Patch.Apply(Data))
+		return FIniPatch();
+
+	OnCommitted().Broadcast(Data, Patch);
+
+	return Patch;
+}
+
+FIniPatch FIniTransaction::Commit(FIniConcurrentStore& Store)
+{
+	FIniPatch Patch = BuildPatch();
+
+	if (Patch.IsEmpty())
+		return Patch;
+
+	bool bApplied = false;
+
+	// The version this commit produced; the store may already hold a newer one by the time listeners run.
+	const FIniConcurrentStore::FSnapshot Published = Store.Update([&Patch, &bApplied](FIniData& Data)
+	{
+		bApplied = Patch.Apply(Data);
+	});
+
+	if (!bApplied)
+		return FIniPatch();
+
+	if (IsInGameThread())
+	{
+		OnCommitted().Broadcast(Published.Get(), Patch);
+	}
+	else
+	{
+		AsyncTask(ENamedThreads::GameThread, [Published, Patch]()
+		{
+			OnCommitted().Broadcast(Published.Get(), Patch);
+		});
+	}
+
+	return Patch;
+}
+
+FOnIniTransactionCommitted& FIniTransaction::OnCommitted()
+{
+	static FOnIniTransactionCommitted Delegate;
+	return Delegate;
+}
+
+FIniPatch FIniTransaction::BuildPatch()
+{
+	Edits.StableSort([](const FIniPatchEntry& A, const FIniPatchEntry& B)
+	{
+		if (A.bGlobal != B.bGlobal)
+			return A.bGlobal;
+
+		return A.Section.FastLess(B.Section);
+	});
+
+	FIniPatch Patch;
+
+	for (FIniPatchEntry& Edit : Edits)
+		Patch.AddEntry(MoveTemp(Edit));
+
+	Edits.Reset();
+	return Patch;
+}
\ No newline at end of file
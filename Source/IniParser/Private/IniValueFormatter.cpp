@@ -0,0 +1,68 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniValueFormatter.h"
+
+#include "IniParserCore/IniValues.h"
+
+static_assert(FIniValueFormatter::MAX_NUMBER_LENGTH >= IniParserCore::MAX_NUMBER_LENGTH, "Formatter buffers must hold any IniParserCore number");
+
+namespace IniValueFormatter
+{
+	static FORCEINLINE int32 Widen(const ANSICHAR* Ansi, int32 Len, TCHAR* Buffer)
+	{
+		for (int32 Index = 0; Index <= Len; ++Index)
+			Buffer[Index] = static_cast<TCHAR>(Ansi[Index]);
+
+		return Len;
+	}
+}
+
+int32 FIniValueFormatter::FormatDouble(double Value, TCHAR* Buffer)
+{
+	ANSICHAR Ansi[MAX_NUMBER_LENGTH];
+	return IniValueFormatter::Widen(Ansi, IniParserCore::FormatDouble(Value, Ansi), Buffer);
+}
+
+int32 FIniValueFormatter::FormatFloat(float Value, TCHAR* Buffer)
+{
+	ANSICHAR Ansi[MAX_NUMBER_LENGTH];
+	return IniValueFormatter::Widen(Ansi, IniParserCore::FormatFloat(Value, Ansi), Buffer);
+}
+
+void FIniValueFormatter::AppendDouble(FString& Out, double Value)
+{
+	TCHAR Buffer[MAX_NUMBER_LENGTH];
+	Out.AppendChars(Buffer, FormatDouble(Value, Buffer));
+}
+
+void FIniValueFormatter::AppendFloat(FString& Out, float Value)
+{
+	TCHAR Buffer[MAX_NUMBER_LENGTH];
+	Out.AppendChars(Buffer, FormatFloat(Value, Buffer));
+}
+
+void FIniValueFormatter::AppendComponents(FString& Out, const TCHAR* Keys, const double* Values, int32 NumValues)
+{
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		if (Index > 0)
+			Out.AppendChar(TEXT(' '));
+
+		Out.AppendChar(Keys[Index]);
+		Out.AppendChar(TEXT('='));
+		AppendDouble(Out, Values[Index]);
+	}
+}
+
+void FIniValueFormatter::AppendComponents(FString& Out, const TCHAR* Keys, const float* Values, int32 NumValues)
+{
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		if (Index > 0)
+			Out.AppendChar(TEXT(' '));
+
+		Out.AppendChar(Keys[Index]);
+		Out.AppendChar(TEXT('='));
+		AppendFloat(Out, Values[Index]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniValueParser.h"
+
+#include "IniParserCore/IniValues.h"
+
+namespace IniValueParser
+{
+	static FORCEINLINE bool ParseSigned(const FString& String, int64 Min, int64 Max, int64& OutValue)
+	{
+		int64_t Value;
+		if (!IniParserCore::ParseIntegerValue(*String, *String + String.Len(), Min, Max, Value))
+			return false;
+
+		OutValue = Value;
+		return true;
+	}
+
+	static FORCEINLINE bool ParseWholeNumber(const FString& String, double& OutValue)
+	{
+		return IniParserCore::ParseNumberValue(*String, *String + String.Len(), OutValue);
+	}
+
+	static FORCEINLINE bool ParseLiteral(const FString& String, const char* Keys, double* OutValues, int32 NumKeys, int32 NumRequired)
+	{
+		return IniParserCore::ParseComponents(*String, *String + String.Len(), Keys, OutValues, NumKeys, NumRequired);
+	}
+}
+
+bool FIniValueParser::ParseInt32(const FString& String, int32& OutValue)
+{
+	int64 Value;
+	if (!IniValueParser::ParseSigned(String, MIN_int32, MAX_int32, Value))
+		return false;
+
+	OutValue = static_cast<int32>(Value);
+	return true;
+}
+
+bool FIniValueParser::ParseInt64(const FString& String, int64& OutValue)
+{
+	return IniValueParser::ParseSigned(String, MIN_int64, MAX_int64, OutValue);
+}
+
+bool FIniValueParser::ParseDouble(const FString& String, double& OutValue)
+{
+	return IniValueParser::ParseWholeNumber(String, OutValue);
+}
+
+bool FIniValueParser::ParseFloat(const FString& String, float& OutValue)
+{
+	double Value;
+	if (!IniValueParser::ParseWholeNumber(String, Value))
+		return false;
+
+	OutValue = static_cast<float>(Value);
+	return true;
+}
+
+bool FIniValueParser::ParseVector(const FString& String, FVector& OutValue)
+{
+	double Values[3];
+	if (!IniValueParser::ParseLiteral(String, "XYZ", Values, 3, 3))
+		return false;
+
+	OutValue = FVector(Values[0], Values[1], Values[2]);
+	return true;
+}
+
+bool FIniValueParser::ParseVector3f(const FString& String, FVector3f& OutValue)
+{
+	double Values[3];
+	if (!IniValueParser::ParseLiteral(String, "XYZ", Values, 3, 3))
+		return false;
+
+	OutValue = FVector3f(static_cast<float>(Values[0]), static_cast<float>(Values[1]), static_cast<float>(Values[2]));
+	return true;
+}
+
+bool FIniValueParser::ParseVector2D(const FString& String, FVector2D& OutValue)
+{
+	double Values[2];
+	if (!IniValueParser::ParseLiteral(String, "XY", Values, 2, 2))
+		return false;
+
+	OutValue = FVector2D(Values[0], Values[1]);
+	return true;
+}
+
+bool FIniValueParser::ParseRotator(const FString& String, FRotator& OutValue)
+{
+	double Values[3];
+	if (!IniValueParser::ParseLiteral(String, "PYR", Values, 3, 3))
+		return false;
+
+	OutValue = FRotator(Values[0], Values[1], Values[2]);
+	return true;
+}
+
+bool FIniValueParser::ParseColor(const FString& String, FLinearColor& OutValue)
+{
+	double Values[4] = { 0.0, 0.0, 0.0, 1.0 };
+	if (!IniValueParser::ParseLiteral(String, "RGBA", Values, 4, 3))
+		return false;
+
+	OutValue = FLinearColor(static_cast<float>(Values[0]), static_cast<float>(Values[1]), static_cast<float>(Values[2]), static_cast<float>(Values[3]));
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniLibrary.h"
+#include "IniDataBuilder.h"
+#include "IniTestUtils.h"
+
+/* Heap allocations of a presized parse against the same parse with every container left to grow on its own */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniPresizedParseAllocationsTest, "IniParser.Performance.PresizedParseAllocations", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniPresizedParseAllocationsTest::RunTest(const FString& Parameters)
+{
+	const int32 NumSections = 200;
+	const int32 NumProperties = 64;
+	const FString Corpus = IniTestUtils::MakeCorpus(NumSections, NumProperties);
+
+	// Create every FName once, so neither run pays for name table growth.
+	const FIniData Reference = UIniLibrary::ParseIniFromString(Corpus);
+
+	int32 NumStrings = Reference.GetNumOfComments();
+
+	for (const auto& Pair : Reference.GetSections())
+		NumStrings += Pair.Value.GetNumOfComments() + Pair.Value.GetNumOfProperties();
+
+	int64 NumPresized = 0;
+	int64 NumGrown = 0;
+
+	{
+		FString Source = Corpus;
+		FIniAllocationCounter Counter;
+
+		const FIniData Data = UIniLibrary::ParseIniFromString(MoveTemp(Source));
+		NumPresized = Counter.GetNumAllocations();
+	}
+
+	{
+		// Zero counts make every Reserve a no-op, which is how documents were filled before presizing.
+		TArray<FIniEntryCounts> NoCounts;
+		NoCounts.AddDefaulted();
+
+		FIniAllocationCounter Counter;
+		FIniData Data;
+		FIniDataBuilder Builder{ Data, NoCounts };
+
+		IniParserCore::Tokenize(*Corpus, *Corpus + Corpus.Len(), Builder);
+		NumGrown = Counter.GetNumAllocations();
+	}
+
+	AddInfo(FString::Printf(TEXT("%d sections, %d strings: %lld allocations presized, %lld growing (%.2f vs %.2f per entry)"),
+		NumSections, NumStrings, NumPresized, NumGrown, static_cast<double>(NumPresized) / NumStrings, static_cast<double>(NumGrown) / NumStrings));
+
+	// One allocation per value and comment string, plus a handful per section for its maps and comment array.
+	TestTrue(TEXT("Presizing removes container growth"), NumPresized < NumGrown);
+	TestTrue(TEXT("Containers cost a fixed number of allocations per section"), NumPresized - NumStrings <= 4 * (NumSections + 1) + 32);
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,286 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniLibrary.h"
+#include "IniTestUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+/* One measured number; written as "<value> <unit> <name>" lines, the same format as iniparser-bench baselines */
+struct FIniBenchmarkResult
+{
+	FString Name;
+	double Value;
+	FString Unit;
+};
+
+/* Synthetic corpus of one size and shape */
+struct FIniBenchmarkCorpus
+{
+	FString Name;
+	int32 NumSections;
+	int32 NumProperties;
+};
+
+/* Property to read in the getter benchmark. The first letter of the generated key names the kind of value (see IniTestUtils::MakeCorpus). */
+struct FIniBenchmarkKey
+{
+	FName Section;
+	FName Property;
+	TCHAR Kind;
+};
+
+/**
+ * Throughput of the UIniLibrary entry points on synthetic corpora of increasing size, shape and file encoding.
+ * Reports MB/s, ns per entry or lookup, and allocations per entry.
+ *
+ * Command line:
+ *   -IniBenchmarkBaseline=<file>       Compare with saved results, errors on regressions
+ *   -IniBenchmarkWriteBaseline=<file>  Save the results
+ *   -IniBenchmarkTolerance=<percent>   Allowed slowdown before a case counts as a regression (default 15)
+ */
+BEGIN_DEFINE_SPEC(FIniBenchmarkSpec, "IniParser.Performance.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+	TArray<FIniBenchmarkResult> Results;
+
+	/**
+	 * Run Body at least five times and record the fastest run
+	 *
+	 * @param NumItems Entries or lookups per run
+	 * @param NumBytes Text processed per run, 0 to skip MB/s
+	 * @param Body Returns a checksum of its work
+	 */
+	void Measure(const FString& Name, int64 NumItems, int64 NumBytes, const TFunctionRef<double()>& Body, const TCHAR* ItemUnit = TEXT("ns/item"))
+	{
+		double Best = TNumericLimits<double>::Max();
+		double Total = 0.0;
+		double Checksum = 0.0;
+		int64 NumAllocations = 0;
+
+		for (int32 Run = 0; Run < 5 || (Total < 0.2 && Run < 1000); Run++)
+		{
+			FIniAllocationCounter Counter;
+			const double Start = FPlatformTime::Seconds();
+			Checksum += Body();
+			const double Seconds = FPlatformTime::Seconds() - Start;
+
+			NumAllocations = Counter.GetNumAllocations();
+			Best = FMath::Min(Best, Seconds);
+			Total += Seconds;
+		}
+
+		Results.Add({ Name, Best * 1e9 / NumItems, ItemUnit });
+
+		if (NumBytes > 0)
+			Results.Add({ Name, NumBytes / Best / 1e6, TEXT("MB/s") });
+
+		Results.Add({ Name, static_cast<double>(NumAllocations) / NumItems, TEXT("allocs/item") });
+
+		AddInfo(FString::Printf(TEXT("%s: %.1f %s, %.1f MB/s, %.2f allocs/item (checksum %g)"), *Name, Best * 1e9 / NumItems, ItemUnit, NumBytes / Best / 1e6, static_cast<double>(NumAllocations) / NumItems, Checksum));
+	}
+
+	void DefineCorpus(const FIniBenchmarkCorpus& Corpus);
+
+	void CompareBaseline(const FString& Path, double Tolerance);
+
+END_DEFINE_SPEC(FIniBenchmarkSpec)
+
+void FIniBenchmarkSpec::Define()
+{
+	// About 64 KB, 1 MB and 8 MB of text, as many small sections and as one flat section.
+	const FIniBenchmarkCorpus Corpora[] = {
+		{ TEXT("config/64k"), 40, 32 },
+		{ TEXT("config/1m"), 640, 32 },
+		{ TEXT("config/8m"), 5120, 32 },
+		{ TEXT("flat/64k"), 1, 1280 },
+		{ TEXT("flat/1m"), 1, 20480 },
+		{ TEXT("flat/8m"), 1, 163840 },
+	};
+
+	for (const FIniBenchmarkCorpus& Corpus : Corpora)
+		DefineCorpus(Corpus);
+
+	It(TEXT("compares with the baseline"), [this]()
+	{
+		FString WritePath;
+
+		if (FParse::Value(FCommandLine::Get(), TEXT("-IniBenchmarkWriteBaseline="), WritePath))
+		{
+			TArray<FString> Lines;
+
+			for (const FIniBenchmarkResult& Result : Results)
+				Lines.Add(FString::Printf(TEXT("%.9g %s %s"), Result.Value, *Result.Unit, *Result.Name));
+
+			TestTrue(FString::Printf(TEXT("Write %s"), *WritePath), FFileHelper::SaveStringArrayToFile(Lines, *WritePath));
+		}
+
+		FString BaselinePath;
+		float TolerancePercent = 15.0f;
+		FParse::Value(FCommandLine::Get(), TEXT("-IniBenchmarkTolerance="), TolerancePercent);
+
+		if (FParse::Value(FCommandLine::Get(), TEXT("-IniBenchmarkBaseline="), BaselinePath))
+			CompareBaseline(BaselinePath, TolerancePercent / 100.0);
+	});
+}
+
+void FIniBenchmarkSpec::DefineCorpus(const FIniBenchmarkCorpus& Corpus)
+{
+	Describe(Corpus.Name, [this, Corpus]()
+	{
+		It(TEXT("measures parsing, writing, files and getters"), [this, Corpus]()
+		{
+			const FString Text = IniTestUtils::MakeCorpus(Corpus.NumSections, Corpus.NumProperties);
+			const FString Prefix = Corpus.Name + TEXT(" ");
+
+			FIniData Data = UIniLibrary::ParseIniFromString(Text);
+			int64 NumEntries = Data.GetNumOfSections();
+
+			for (const auto& SectionPair : Data.GetSections())
+				NumEntries += SectionPair.Value.GetNumOfProperties() + SectionPair.Value.GetNumOfComments();
+
+			Measure(Prefix + TEXT("ParseIniFromString"), NumEntries, Text.Len() * sizeof(TCHAR), [&Text]()
+			{
+				return static_cast<double>(UIniLibrary::ParseIniFromString(Text).GetNumOfSections());
+			});
+
+			const int64 NumWritten = UIniLibrary::ParseIniToString(Data).Len() * sizeof(TCHAR);
+
+			Measure(Prefix + TEXT("ParseIniToString"), NumEntries, NumWritten, [&Data]()
+			{
+				return static_cast<double>(UIniLibrary::ParseIniToString(Data).Len());
+			});
+
+			const FString FilePath = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("IniBenchmark"), TEXT(".ini"));
+
+			Measure(Prefix + TEXT("WriteIniToFile"), NumEntries, NumWritten, [&Data, &FilePath]()
+			{
+				UIniLibrary::WriteIniToFile(FilePath, Data);
+				return 1.0;
+			});
+
+			// The same text saved in each encoding ReadIniFromFile accepts.
+			const TPair<const TCHAR*, FFileHelper::EEncodingOptions> Encodings[] = {
+				{ TEXT("utf8"), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM },
+				{ TEXT("utf16"), FFileHelper::EEncodingOptions::ForceUnicode },
+			};
+
+			for (const auto& Encoding : Encodings)
+			{
+				FFileHelper::SaveStringToFile(Text, *FilePath, Encoding.Value);
+				const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+
+				Measure(Prefix + TEXT("ReadIniFromFile ") + Encoding.Key, NumEntries, FileSize, [&FilePath]()
+				{
+					return static_cast<double>(UIniLibrary::ReadIniFromFile(FilePath).GetNumOfSections());
+				});
+			}
+
+			IFileManager::Get().Delete(*FilePath);
+
+			// Every key once, in a shuffled order, read through the typed getter for its kind of value.
+			TArray<FIniBenchmarkKey> Keys;
+
+			for (const auto& SectionPair : Data.GetSections())
+			{
+				for (const auto& PropertyPair : SectionPair.Value.GetProperties())
+					Keys.Add({ SectionPair.Key, PropertyPair.Key, PropertyPair.Key.ToString()[0] });
+			}
+
+			FRandomStream Random(36);
+
+			for (int32 Index = Keys.Num() - 1; Index > 0; Index--)
+				Keys.Swap(Index, Random.RandRange(0, Index));
+
+			Measure(Prefix + TEXT("getters"), Keys.Num(), 0, [&Data, &Keys]()
+			{
+				double Sum = 0.0;
+
+				for (const FIniBenchmarkKey& Key : Keys)
+				{
+					switch (Key.Kind)
+					{
+						case TEXT('C'):
+						{
+							int32 Value;
+							UIniLibrary::GetPropertyValueAsInt(Data, Key.Section, Key.Property, Value);
+							Sum += Value;
+							break;
+						}
+
+						case TEXT('S'):
+						{
+							double Value;
+							UIniLibrary::GetPropertyValueAsDouble(Data, Key.Section, Key.Property, Value);
+							Sum += Value;
+							break;
+						}
+
+						case TEXT('O'):
+						{
+							FVector Value;
+							bool bIsValid;
+							UIniLibrary::GetPropertyValueAsVector(Data, Key.Section, Key.Property, Value, bIsValid);
+							Sum += Value.X;
+							break;
+						}
+
+						default:
+						{
+							FString Value;
+							UIniLibrary::GetPropertyValueAsString(Data, Key.Section, Key.Property, Value);
+							Sum += Value.Len();
+							break;
+						}
+					}
+				}
+
+				return Sum;
+			}, TEXT("ns/lookup"));
+		});
+	});
+}
+
+void FIniBenchmarkSpec::CompareBaseline(const FString& Path, double Tolerance)
+{
+	TArray<FString> Lines;
+
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		AddError(FString::Printf(TEXT("Can not read the baseline %s"), *Path));
+		return;
+	}
+
+	TMap<FString, double> Baseline;
+
+	for (const FString& Line : Lines)
+	{
+		FString Value, Rest, Unit, Name;
+
+		if (Line.Split(TEXT(" "), &Value, &Rest) && Rest.Split(TEXT(" "), &Unit, &Name))
+			Baseline.Add(Name + TEXT(" ") + Unit, FCString::Atod(*Value));
+	}
+
+	for (const FIniBenchmarkResult& Result : Results)
+	{
+		const double* Before = Baseline.Find(Result.Name + TEXT(" ") + Result.Unit);
+
+		if (Before == nullptr)
+			continue;
+
+		// Lower MB/s is worse; for every other unit higher is worse.
+		const bool bRegressed = Result.Unit == TEXT("MB/s")
+			? Result.Value < *Before * (1.0 - Tolerance)
+			: Result.Value > *Before * (1.0 + Tolerance) + (Result.Unit == TEXT("allocs/item") ? 1e-9 : 0.0);
+
+		if (bRegressed)
+			AddError(FString::Printf(TEXT("Regression in %s: %.2f %s, baseline %.2f"), *Result.Name, Result.Value, *Result.Unit, *Before));
+	}
+}
+
+#endif
\ No newline at end of file
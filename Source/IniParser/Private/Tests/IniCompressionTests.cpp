@@ -0,0 +1,125 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniCompression.h"
+#include "IniLibrary.h"
+#include "IniTestUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace IniCompressionTests
+{
+	/* Fastest of five runs of Body, in seconds */
+	static double MeasureBest(const TFunctionRef<void()>& Body)
+	{
+		double Best = TNumericLimits<double>::Max();
+
+		for (int32 Run = 0; Run < 5; Run++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Body();
+			Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+		}
+
+		return Best;
+	}
+}
+
+/* Reading a compressed file (decode + parse) against parsing the same text from memory and from a plain file */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniCompressedReadTest, "IniParser.Performance.CompressedRead", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniCompressedReadTest::RunTest(const FString& Parameters)
+{
+	using namespace IniCompressionTests;
+
+	const FString Text = IniTestUtils::MakeCorpus(640, 32);
+	const FIniData Data = UIniLibrary::ParseIniFromString(Text);
+	const int64 NumBytes = FTCHARToUTF8(*Text, Text.Len()).Length();
+
+	const double ParseSeconds = MeasureBest([&Text]() { UIniLibrary::ParseIniFromString(Text); });
+	AddInfo(FString::Printf(TEXT("ParseIniFromString: %.1f MB/s"), NumBytes / ParseSeconds / 1e6));
+
+	const FString PlainPath = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("IniCompression"), TEXT(".ini"));
+	FFileHelper::SaveStringToFile(Text, *PlainPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+	const double PlainSeconds = MeasureBest([&PlainPath]() { UIniLibrary::ReadIniFromFile(PlainPath); });
+	AddInfo(FString::Printf(TEXT("ReadIniFromFile: %.1f MB/s"), NumBytes / PlainSeconds / 1e6));
+
+	IFileManager::Get().Delete(*PlainPath);
+
+	const EIniCompressionFormat Formats[] = { EIniCompressionFormat::Zlib, EIniCompressionFormat::Gzip, EIniCompressionFormat::LZ4, EIniCompressionFormat::Oodle };
+
+	for (EIniCompressionFormat Format : Formats)
+	{
+		const FName FormatName = FIniCompression::GetFormatName(Format);
+
+		if (!FCompression::IsFormatValid(FormatName))
+			continue;
+
+		const FString FilePath = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("IniCompression"), TEXT(".iniz"));
+
+		if (!TestTrue(FString::Printf(TEXT("Write %s"), *FormatName.ToString()), FIniCompression::WriteToFile(FilePath, Data, Format)))
+			continue;
+
+		const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+		FIniData Decoded;
+
+		const double Seconds = MeasureBest([&FilePath, &Decoded]() { FIniCompression::ReadFromFile(FilePath, Decoded); });
+
+		AddInfo(FString::Printf(TEXT("%s: %.1f MB/s of text (%.1fx the in-memory parse time), %.1f%% of the text size"),
+			*FormatName.ToString(), NumBytes / Seconds / 1e6, Seconds / ParseSeconds, 100.0 * FileSize / NumBytes));
+
+		TestEqual(FString::Printf(TEXT("%s decodes every section"), *FormatName.ToString()), Decoded.GetNumOfSections(), Data.GetNumOfSections());
+
+		IFileManager::Get().Delete(*FilePath);
+	}
+
+	return true;
+}
+
+/* Compressed files whose header does not match the format or the file size are rejected before any chunk is allocated */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniCompressedHeaderTest, "IniParser.Compression.RejectsMalformedHeaders", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniCompressedHeaderTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("IniCompression"), TEXT(".iniz"));
+
+	FIniCompression::WriteToFile(FilePath, UIniLibrary::ParseIniFromString(IniTestUtils::MakeCorpus(8, 16)), EIniCompressionFormat::Zlib);
+
+	TArray<uint8> Valid;
+	FFileHelper::LoadFileToArray(Valid, *FilePath);
+
+	// Offsets in the header: ChunkSize at 8, UncompressedSize at 12, chunk count at 20, first compressed size at 24.
+	const TPair<const TCHAR*, TFunction<void(TArray<uint8>&)>> Cases[] = {
+		{ TEXT("chunk size above CHUNK_SIZE"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint32*>(Bytes.GetData() + 8) = MAX_uint32; } },
+		{ TEXT("text size above MAX_int32"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint64*>(Bytes.GetData() + 12) = MAX_uint64; } },
+		{ TEXT("chunk count not matching the text size"), [](TArray<uint8>& Bytes) { *reinterpret_cast<int32*>(Bytes.GetData() + 20) = MAX_int32; } },
+		{ TEXT("compressed size past the end of the file"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint32*>(Bytes.GetData() + 24) = MAX_uint32 - 1; } },
+		{ TEXT("truncated payload"), [](TArray<uint8>& Bytes) { Bytes.SetNum(Bytes.Num() - 1); } },
+	};
+
+	FIniData Data;
+	TestTrue(TEXT("The unmodified file reads"), FIniCompression::ReadFromFile(FilePath, Data));
+
+	AddExpectedError(TEXT("Unsupported compressed .ini header"), EAutomationExpectedErrorFlags::Contains, UE_ARRAY_COUNT(Cases));
+
+	for (const auto& Case : Cases)
+	{
+		TArray<uint8> Bytes = Valid;
+		Case.Value(Bytes);
+		FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+
+		TestFalse(Case.Key, FIniCompression::ReadFromFile(FilePath, Data));
+	}
+
+	IFileManager::Get().Delete(*FilePath);
+
+	return true;
+}
+
+#endif
\ No newline at end of file
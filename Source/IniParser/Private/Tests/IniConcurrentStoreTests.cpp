@@ -0,0 +1,157 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniConcurrentStore.h"
+#include "Async/Async.h"
+#include "Misc/ScopeRWLock.h"
+
+#include <atomic>
+
+namespace IniConcurrentStoreTests
+{
+	static const FName VERSION_KEY(TEXT("Version"));
+	static const FName CHECK_KEY(TEXT("Check"));
+
+	// Both properties always hold the same number, so a reader that sees them differ saw a torn version.
+	static FIniData MakeVersion(int32 Number)
+	{
+		FIniData Data;
+		Data.AddProperty(VERSION_KEY, FString::FromInt(Number));
+		Data.AddProperty(CHECK_KEY, FString::FromInt(Number));
+
+		return Data;
+	}
+
+	struct FRunResult
+	{
+		int64 NumReads = 0;
+		int64 NumTornReads = 0;
+		int32 NumPublished = 0;
+		double Seconds = 0.0;
+	};
+
+	/**
+	 * Run NumReaders threads reading both properties in a loop while the calling thread publishes a new version every WritePeriod
+	 *
+	 * @param MakeReader Called once on each reader thread; returns a callable invoked as Read(int32& OutVersion, int32& OutCheck)
+	 * @param Write Invoked as Write(int32 Number) on the calling thread
+	 */
+	template <typename ReadFactoryType, typename WriteType>
+	static FRunResult Run(int32 NumReaders, double Duration, double WritePeriod, ReadFactoryType&& MakeReader, WriteType&& Write)
+	{
+		std::atomic<bool> bStop(false);
+		std::atomic<int64> NumReads(0);
+		std::atomic<int64> NumTornReads(0);
+
+		TArray<TFuture<void>> Readers;
+
+		for (int32 Index = 0; Index < NumReaders; Index++)
+		{
+			Readers.Add(Async(EAsyncExecution::Thread, [&]()
+			{
+				auto Read = MakeReader();
+				int64 Reads = 0;
+				int64 Torn = 0;
+
+				while (!bStop.load(std::memory_order_relaxed))
+				{
+					int32 Version, Check;
+					Read(Version, Check);
+
+					Torn += Version != Check;
+					Reads++;
+				}
+
+				NumReads += Reads;
+				NumTornReads += Torn;
+			}));
+		}
+
+		FRunResult Result;
+		const double Start = FPlatformTime::Seconds();
+
+		while (FPlatformTime::Seconds() - Start < Duration)
+		{
+			FPlatformProcess::Sleep(static_cast<float>(WritePeriod));
+			Write(++Result.NumPublished);
+		}
+
+		bStop = true;
+
+		for (TFuture<void>& Reader : Readers)
+			Reader.Wait();
+
+		Result.Seconds = FPlatformTime::Seconds() - Start;
+		Result.NumReads = NumReads;
+		Result.NumTornReads = NumTornReads;
+
+		return Result;
+	}
+
+	static int32 ReadNumber(const FIniData& Data, const FName& Key)
+	{
+		const FIniProperty* Property = Data.GetProperties().Find(Key);
+		return Property ? FCString::Atoi(*Property->GetValue()) : -1;
+	}
+}
+
+/* Read throughput of 32 threads while one writer publishes periodically: FIniConcurrentStore readers against an FIniData behind a read/write lock */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniConcurrentStoreContentionTest, "IniParser.Performance.ConcurrentStoreContention", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniConcurrentStoreContentionTest::RunTest(const FString& Parameters)
+{
+	using namespace IniConcurrentStoreTests;
+
+	const int32 NumReaders = 32;
+	const double Duration = 2.0;
+	const double WritePeriod = 0.01;
+
+	FIniConcurrentStore Store(MakeVersion(0));
+
+	const FRunResult StoreResult = Run(NumReaders, Duration, WritePeriod,
+		[&Store]()
+		{
+			return [Reader = FIniConcurrentStore::FReader(Store)](int32& OutVersion, int32& OutCheck) mutable
+			{
+				const FIniData& Data = Reader.Get();
+				OutVersion = ReadNumber(Data, VERSION_KEY);
+				OutCheck = ReadNumber(Data, CHECK_KEY);
+			};
+		},
+		[&Store](int32 Number) { Store.Publish(MakeVersion(Number)); });
+
+	FRWLock Lock;
+	FIniData Locked = MakeVersion(0);
+
+	const FRunResult LockedResult = Run(NumReaders, Duration, WritePeriod,
+		[&Lock, &Locked]()
+		{
+			return [&Lock, &Locked](int32& OutVersion, int32& OutCheck)
+			{
+				FReadScopeLock ReadLock(Lock);
+				OutVersion = ReadNumber(Locked, VERSION_KEY);
+				OutCheck = ReadNumber(Locked, CHECK_KEY);
+			};
+		},
+		[&Lock, &Locked](int32 Number)
+		{
+			FIniData NewData = MakeVersion(Number);
+			FWriteScopeLock WriteLock(Lock);
+			Locked = MoveTemp(NewData);
+		});
+
+	AddInfo(FString::Printf(TEXT("%d readers, %d and %d publishes: FIniConcurrentStore %.1f M reads/s (%.1f ns/read per thread), FRWLock %.1f M reads/s (%.1f ns/read per thread)"),
+		NumReaders, StoreResult.NumPublished, LockedResult.NumPublished,
+		StoreResult.NumReads / StoreResult.Seconds / 1e6, StoreResult.Seconds * NumReaders * 1e9 / StoreResult.NumReads,
+		LockedResult.NumReads / LockedResult.Seconds / 1e6, LockedResult.Seconds * NumReaders * 1e9 / LockedResult.NumReads));
+
+	TestEqual(TEXT("Readers never see a torn version"), StoreResult.NumTornReads, static_cast<int64>(0));
+	TestEqual(TEXT("Every publish is visible"), Store.GetVersion(), static_cast<uint64>(StoreResult.NumPublished + 1));
+
+	return true;
+}
+
+#endif
\ No newline at end of file
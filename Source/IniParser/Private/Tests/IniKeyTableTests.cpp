@@ -0,0 +1,204 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniKeyTable.h"
+#include "IniLibrary.h"
+#include "IniSharedData.h"
+#include "IniTransaction.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace IniKeyTableTests
+{
+	static const TCHAR* const CASE_SENSITIVE_SOURCE = TEXT("Global = 1\n[Section]\nKey = 2\nkey = 3\n");
+
+	/* Check that a copy holds the keyed properties of CASE_SENSITIVE_SOURCE */
+	static void TestKeyedCopy(FAutomationTestBase& Test, const FString& What, FIniData& Copy)
+	{
+		Test.TestTrue(What + TEXT(": key mode"), Copy.GetKeyMode() == EIniKeyMode::CaseSensitive);
+		Test.TestNotNull(What + TEXT(": global keyed property"), Copy.FindPropertyByString(TEXT("Global")));
+
+		FIniSection* Section = Copy.FindSection(TEXT("Section"));
+
+		if (!Test.TestNotNull(What + TEXT(": section"), Section))
+			return;
+
+		const FIniProperty* Lower = Section->FindPropertyByString(TEXT("key"));
+
+		Test.TestEqual(What + TEXT(": keys differing in case"), Section->GetKeyedProperties().Num(), 2);
+
+		if (Test.TestNotNull(What + TEXT(": lower-case key"), Lower))
+			Test.TestEqual(What + TEXT(": lower-case value"), Lower->GetValue(), FString(TEXT("3")));
+	}
+}
+
+/* Removing keys swaps the last entry into the gap; every remaining key must still be found with its own value */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniKeyTableRemoveTest, "IniParser.KeyTable.Remove", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniKeyTableRemoveTest::RunTest(const FString& Parameters)
+{
+	const int32 NumKeys = 100;
+	FIniKeyTable Table;
+
+	for (int32 Index = 0; Index < NumKeys; Index++)
+		Table.FindOrAdd(FString::Printf(TEXT("Key%d"), Index), FString::FromInt(Index));
+
+	for (int32 Index = 0; Index < NumKeys; Index += 3)
+		TestTrue(FString::Printf(TEXT("Remove Key%d"), Index), Table.Remove(FString::Printf(TEXT("Key%d"), Index)));
+
+	TestFalse(TEXT("Removing a missing key"), Table.Remove(TEXT("Key0")));
+	TestEqual(TEXT("Entries left"), Table.Num(), NumKeys - (NumKeys + 2) / 3);
+
+	for (int32 Index = 0; Index < NumKeys; Index++)
+	{
+		const FIniProperty* Property = Table.Find(FString::Printf(TEXT("Key%d"), Index));
+
+		if (Index % 3 == 0)
+			TestNull(FString::Printf(TEXT("Key%d is gone"), Index), Property);
+		else if (TestNotNull(FString::Printf(TEXT("Key%d is found"), Index), Property))
+			TestEqual(FString::Printf(TEXT("Key%d keeps its value"), Index), Property->GetValue(), FString::FromInt(Index));
+	}
+
+	return true;
+}
+
+/* Case-sensitive documents are reachable through the typed accessors and survive FIniSharedData */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniKeyTableDocumentTest, "IniParser.KeyTable.CaseSensitiveDocument", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniKeyTableDocumentTest::RunTest(const FString& Parameters)
+{
+	const FName SectionName(TEXT("IniKeyTableTests"));
+	const FName PropertyName(TEXT("IniKeyTableTestsCount"));
+
+	FIniData Data = UIniLibrary::ParseIniFromStringWithKeyMode(TEXT("Global = 1\n[IniKeyTableTests]\nIniKeyTableTestsCount = 2\ninikeytabletestscount = 3\n"), EIniKeyMode::CaseSensitive);
+
+	int32 Value = 0;
+	UIniLibrary::GetPropertyValueAsInt(Data, SectionName, PropertyName, Value);
+	TestEqual(TEXT("Typed getter reads the keyed property"), Value, 2);
+
+	UIniLibrary::SetPropertyValueAsInt(Data, SectionName, PropertyName, 4);
+	UIniLibrary::GetPropertyValueAsInt(Data, SectionName, PropertyName, Value);
+	TestEqual(TEXT("Typed setter writes the keyed property"), Value, 4);
+
+	UIniLibrary::GetGlobalPropertyValueAsInt(Data, TEXT("Global"), Value);
+	TestEqual(TEXT("Typed global getter reads the keyed property"), Value, 1);
+
+	const FIniData Copy = FIniSharedData(Data).ToIniData();
+	FIniData MutableCopy = Copy;
+
+	TestTrue(TEXT("FIniSharedData keeps the key mode"), Copy.GetKeyMode() == EIniKeyMode::CaseSensitive);
+	TestNotNull(TEXT("FIniSharedData keeps keyed global properties"), MutableCopy.FindPropertyByString(TEXT("Global")));
+
+	FIniData Named = UIniLibrary::ParseIniFromString(TEXT("None = 5\n"));
+	TestNotNull(TEXT("A key named None is found by its text"), Named.FindPropertyByString(TEXT("None")));
+
+	return true;
+}
+
+/* Duplicate-key diagnostics compare keys the way the document stores them */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniKeyTableDiagnosticsTest, "IniParser.KeyTable.DuplicateDiagnostics", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniKeyTableDiagnosticsTest::RunTest(const FString& Parameters)
+{
+	const FString Source = TEXT("[S]\nKey = 1\nkey = 2\nKey = 3\n");
+
+	TArray<FIniDiagnostic> Diagnostics;
+	UIniLibrary::ParseIniFromStringWithDiagnostics(Source, Diagnostics);
+	TestEqual(TEXT("FName keys: both repeats are duplicates"), Diagnostics.Num(), 2);
+
+	const FIniData Data = UIniLibrary::ParseIniFromStringWithDiagnostics(Source, Diagnostics, EIniKeyMode::CaseSensitive);
+	TestEqual(TEXT("Case-sensitive keys: only the exact repeat is a duplicate"), Diagnostics.Num(), 1);
+	TestTrue(TEXT("The document keeps the key mode"), Data.GetKeyMode() == EIniKeyMode::CaseSensitive);
+
+	return true;
+}
+
+/* Lazily parsed case-sensitive documents keep their key mode for global entries and for sections parsed later */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniKeyTableLazyTest, "IniParser.KeyTable.LazyParse", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniKeyTableLazyTest::RunTest(const FString& Parameters)
+{
+	FIniData Data = UIniLibrary::ParseIniFromStringLazy(TEXT("Global = 1\n[Lazy]\nKey = 2\nkey = 3\n"), EIniKeyMode::CaseSensitive);
+
+	TestTrue(TEXT("Pending sections count as keyed"), Data.HasKeyedProperties());
+	TestNotNull(TEXT("Global entries are keyed"), Data.GetKeyedProperties().Find(TEXT("Global")));
+
+	FIniSection* Section = Data.FindSection(TEXT("Lazy"));
+
+	if (TestNotNull(TEXT("The section is found"), Section))
+	{
+		TestEqual(TEXT("Keys differing in case stay apart"), Section->GetKeyedProperties().Num(), 2);
+
+		const FIniProperty* Property = Section->FindPropertyByString(TEXT("key"));
+
+		if (TestNotNull(TEXT("The lower-case key is found"), Property))
+			TestEqual(TEXT("The lower-case key keeps its value"), Property->GetValue(), FString(TEXT("3")));
+	}
+
+	return true;
+}
+
+/* Keyed properties survive binary serialization (assets, duplication) and text export/import (copy and paste) */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniKeyTableSerializeTest, "IniParser.KeyTable.SerializeRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniKeyTableSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace IniKeyTableTests;
+
+	FIniData Data = UIniLibrary::ParseIniFromStringWithKeyMode(CASE_SENSITIVE_SOURCE, EIniKeyMode::CaseSensitive);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FObjectAndNameAsStringProxyArchive WriteArchive(Writer, false);
+	FIniData::StaticStruct()->SerializeItem(WriteArchive, &Data, nullptr);
+
+	FIniData Loaded;
+	FMemoryReader Reader(Bytes);
+	FObjectAndNameAsStringProxyArchive ReadArchive(Reader, false);
+	FIniData::StaticStruct()->SerializeItem(ReadArchive, &Loaded, nullptr);
+
+	TestKeyedCopy(*this, TEXT("Binary"), Loaded);
+	TestKeyedCopy(*this, TEXT("Binary source after saving"), Data);
+
+	FString Text;
+	FIniData::StaticStruct()->ExportText(Text, &Data, nullptr, nullptr, PPF_None, nullptr);
+
+	FIniData Imported;
+	TestNotNull(TEXT("Text import"), FIniData::StaticStruct()->ImportText(*Text, &Imported, nullptr, PPF_None, GLog, TEXT("IniData")));
+	TestKeyedCopy(*this, TEXT("Text"), Imported);
+
+	return true;
+}
+
+/* Patches and transactions name properties by FName, so they refuse case-sensitive documents instead of adding a second copy of a key */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniKeyTablePatchTest, "IniParser.KeyTable.PatchRefused", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniKeyTablePatchTest::RunTest(const FString& Parameters)
+{
+	using namespace IniKeyTableTests;
+
+	FIniData Data = UIniLibrary::ParseIniFromStringWithKeyMode(CASE_SENSITIVE_SOURCE, EIniKeyMode::CaseSensitive);
+	const FString Before = UIniLibrary::ParseIniToString(Data);
+
+	FIniPatch Patch;
+	Patch.AddEntry(FIniPatchEntry(EIniPatchOperation::SetProperty, TEXT("Section"), TEXT("Key"), TEXT("4")));
+
+	AddExpectedError(TEXT("Can not apply a patch to a document with case-sensitive keys"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	TestFalse(TEXT("ApplyPatch refuses the document"), UIniLibrary::ApplyPatch(Data, Patch));
+
+	FIniTransaction Transaction;
+	Transaction.SetProperty(TEXT("Section"), TEXT("Key"), TEXT("4"));
+	TestTrue(TEXT("Commit applies nothing"), Transaction.Commit(Data).IsEmpty());
+
+	TestEqual(TEXT("The document is unchanged"), UIniLibrary::ParseIniToString(Data), Before);
+	TestTrue(TEXT("No FName copy of the key was added"), Data.FindSection(TEXT("Section"))->GetProperties().IsEmpty());
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniPack.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/* Table of contents entries pointing outside the pack, too long to read, or out of hash order are rejected when the pack is opened */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniPackTableOfContentsTest, "IniParser.Pack.RejectsMalformedTableOfContents", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniPackTableOfContentsTest::RunTest(const FString& Parameters)
+{
+	const FString Directory = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("IniPack"));
+	const FString PackPath = Directory + TEXT(".inipack");
+
+	FFileHelper::SaveStringToFile(TEXT("[A]\nKey = 1\n"), *(Directory / TEXT("A.ini")));
+	FFileHelper::SaveStringToFile(TEXT("[B]\nKey = 2\n"), *(Directory / TEXT("B.ini")));
+
+	if (!TestTrue(TEXT("The pack is built"), FIniPack::Build(Directory, PackPath)))
+		return false;
+
+	TArray<uint8> Valid;
+	FFileHelper::LoadFileToArray(Valid, *PackPath);
+
+	// The table starts at 16; an entry is Hash, Offset, Length and Reserved, 24 bytes.
+	const TPair<const TCHAR*, TFunction<void(TArray<uint8>&)>> Cases[] = {
+		{ TEXT("offset past the end of the file"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint64*>(Bytes.GetData() + 24) = MAX_uint64 - 4; } },
+		{ TEXT("length past the end of the file"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint32*>(Bytes.GetData() + 32) = static_cast<uint32>(Bytes.Num()); } },
+		{ TEXT("length above MAX_int32"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint32*>(Bytes.GetData() + 32) = MAX_uint32; } },
+		{ TEXT("hashes out of order"), [](TArray<uint8>& Bytes) { *reinterpret_cast<uint64*>(Bytes.GetData() + 40) = *reinterpret_cast<const uint64*>(Bytes.GetData() + 16); } },
+	};
+
+	FIniPack Pack;
+	TestTrue(TEXT("The unmodified pack opens"), Pack.Open(PackPath));
+	Pack.Close();
+
+	AddExpectedError(TEXT("Not a valid .ini pack"), EAutomationExpectedErrorFlags::Contains, UE_ARRAY_COUNT(Cases) * 2);
+
+	for (const auto& Case : Cases)
+	{
+		TArray<uint8> Bytes = Valid;
+		Case.Value(Bytes);
+		FFileHelper::SaveArrayToFile(Bytes, *PackPath);
+
+		TestFalse(FString(Case.Key) + TEXT(", mapped"), Pack.Open(PackPath, true));
+		TestFalse(FString(Case.Key) + TEXT(", through a file handle"), Pack.Open(PackPath, false));
+	}
+
+	IFileManager::Get().Delete(*PackPath);
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+	return true;
+}
+
+#endif
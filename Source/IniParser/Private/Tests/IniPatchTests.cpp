@@ -0,0 +1,46 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniLibrary.h"
+#include "IniPatch.h"
+
+/* A section named [None] and the global scope are different patch targets, and repeated comments are diffed by count */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniPatchGlobalScopeTest, "IniParser.Patch.GlobalScope", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniPatchGlobalScopeTest::RunTest(const FString& Parameters)
+{
+	FIniData From;
+	From.FindOrAddProperty(TEXT("Key"), TEXT("1"));
+	From.AddComment(TEXT("Shared"));
+
+	FIniSection& NoneSection = From.FindOrAddSection(NAME_None);
+	NoneSection.FindOrAddProperty(TEXT("Key"), TEXT("1"));
+	NoneSection.AddComment(TEXT("Shared"));
+	NoneSection.AddComment(TEXT("Shared"));
+
+	FIniData To = From;
+	To.FindOrAddProperty(TEXT("Key"), FString()) = FIniProperty(TEXT("2"));
+	To.AddComment(TEXT("Shared"));
+	To.FindSection(NAME_None)->RemoveComment(TEXT("Shared"));
+
+	const FIniPatch Patch = FIniPatch::Compute(From, To);
+	TestEqual(TEXT("One property and two comment changes"), Patch.GetEntries().Num(), 3);
+
+	for (const FIniPatchEntry& Entry : Patch.GetEntries())
+	{
+		const bool bExpectGlobal = Entry.Operation != EIniPatchOperation::RemoveComment;
+		TestEqual(TEXT("Each change targets its own scope"), Entry.bGlobal, bExpectGlobal);
+	}
+
+	FIniData Patched = From;
+	TestTrue(TEXT("The patch applies"), Patch.Apply(Patched));
+	TestEqual(TEXT("Applying the patch reproduces the target"), UIniLibrary::ParseIniToString(Patched), UIniLibrary::ParseIniToString(To));
+	TestEqual(TEXT("The [None] section keeps its value"), Patched.FindSection(NAME_None)->GetProperties().FindChecked(TEXT("Key")).GetValue(), FString(TEXT("1")));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,125 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IniLibrary.h"
+#include "IniSharedData.h"
+#include "IniTestUtils.h"
+
+/* Heap footprint of 100 consumers of one ~5 MB document: plain FIniData copies against FIniSharedData handles */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniSharedDataFootprintTest, "IniParser.Performance.SharedDataFootprint", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniSharedDataFootprintTest::RunTest(const FString& Parameters)
+{
+	const int32 NumConsumers = 100;
+	const int32 NumSections = 1000;
+	const FString Corpus = IniTestUtils::MakeCorpus(NumSections, 85);
+	const FName EditedSection(TEXT("/Script/Game.Section0"));
+
+	const FIniData Data = UIniLibrary::ParseIniFromString(Corpus);
+	const FIniSharedData Shared(Data);
+
+	int64 CopyBytes = 0;
+	int64 HandleBytes = 0;
+	int64 EditedHandleBytes = 0;
+
+	{
+		// 100 deep copies would take gigabytes, so measure a few and scale; every copy costs the same.
+		const int32 NumMeasuredCopies = 4;
+		TArray<FIniData> Copies;
+		Copies.Reserve(NumMeasuredCopies);
+
+		FIniAllocationCounter Counter;
+
+		for (int32 Index = 0; Index < NumMeasuredCopies; Index++)
+			Copies.Add(Data);
+
+		CopyBytes = Counter.GetNumBytes() / NumMeasuredCopies * NumConsumers;
+	}
+
+	{
+		TArray<FIniSharedData> Handles;
+		Handles.Reserve(NumConsumers);
+
+		FIniAllocationCounter Counter;
+
+		for (int32 Index = 0; Index < NumConsumers; Index++)
+			Handles.Add(Shared);
+
+		HandleBytes = Counter.GetNumBytes();
+
+		// Each consumer then edits one property of one section.
+		Counter.Reset();
+
+		for (FIniSharedData& Handle : Handles)
+			Handle.FindSectionForEdit(EditedSection)->FindOrAddProperty(TEXT("Edited"), TEXT("True"));
+
+		EditedHandleBytes = Counter.GetNumBytes();
+	}
+
+	AddInfo(FString::Printf(TEXT("%.1f MB of text, %d consumers: %.1f MB as FIniData copies, %.3f MB as FIniSharedData handles, %.1f MB after one edit each"),
+		Corpus.Len() * sizeof(TCHAR) / 1e6, NumConsumers, CopyBytes / 1e6, HandleBytes / 1e6, EditedHandleBytes / 1e6));
+
+	TestEqual(TEXT("Copying a handle allocates nothing"), HandleBytes, static_cast<int64>(0));
+	TestTrue(TEXT("One edit clones only the section table and that section"), EditedHandleBytes * 10 < CopyBytes);
+
+	return true;
+}
+
+/* Editing one section of a shared handle must not copy the global scope, and editing the global scope must not copy any section */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIniSharedDataGlobalScopeTest, "IniParser.SharedData.GlobalScopeIsShared", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIniSharedDataGlobalScopeTest::RunTest(const FString& Parameters)
+{
+	const int32 NumGlobals = 10000;
+	const FName SectionName(TEXT("Section"));
+
+	FIniData Data;
+
+	for (int32 Index = 0; Index < NumGlobals; Index++)
+	{
+		Data.AddProperty(*FString::Printf(TEXT("Global%d"), Index), FString::Printf(TEXT("Value%d"), Index));
+		Data.FindOrAddSection(SectionName).AddProperty(*FString::Printf(TEXT("Key%d"), Index), TEXT("Value"));
+	}
+
+	const FIniSharedData Shared(Data);
+	int64 GlobalsBytes = 0;
+
+	{
+		FIniAllocationCounter Counter;
+		TMap<FName, FIniProperty> Copy = Data.GetProperties();
+		GlobalsBytes = Counter.GetNumBytes();
+	}
+
+	FIniSharedData SectionEdit = Shared;
+	int64 SectionEditBytes = 0;
+
+	{
+		FIniAllocationCounter Counter;
+		SectionEdit.FindSectionForEdit(SectionName)->FindOrAddProperty(TEXT("Edited"), TEXT("True"));
+		SectionEditBytes = Counter.GetNumBytes();
+	}
+
+	FIniSharedData GlobalEdit = Shared;
+	int64 GlobalEditBytes = 0;
+
+	{
+		FIniAllocationCounter Counter;
+		GlobalEdit.EditProperties().Add(TEXT("Edited"), FIniProperty(TEXT("True")));
+		GlobalEditBytes = Counter.GetNumBytes();
+	}
+
+	AddInfo(FString::Printf(TEXT("Global scope %.1f KB; section edit allocated %.1f KB, global edit %.1f KB"), GlobalsBytes / 1e3, SectionEditBytes / 1e3, GlobalEditBytes / 1e3));
+
+	// Both scopes are about the same size, so copying either one would take at least half of GlobalsBytes.
+	TestTrue(TEXT("A section edit does not copy the global scope"), SectionEditBytes < GlobalsBytes + GlobalsBytes / 2);
+	TestTrue(TEXT("A global edit does not copy the section"), GlobalEditBytes < GlobalsBytes + GlobalsBytes / 2);
+	TestEqual(TEXT("The original is unchanged"), Shared.GetNumOfProperties(), NumGlobals);
+	TestNull(TEXT("The original section is unchanged"), Shared.FindSection(SectionName)->GetProperties().Find(TEXT("Edited")));
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+/**
+ * Counts heap allocations made by one thread while it is in scope. GMalloc is wrapped for the lifetime of the counter and
+ * every call is forwarded, so memory allocated under it may be freed after it is gone. Other threads are forwarded without counting.
+ */
+class FIniAllocationCounter final : public FMalloc
+{
+public:
+	FIniAllocationCounter()
+		: Inner(GMalloc)
+		, ThreadId(FPlatformTLS::GetCurrentThreadId())
+	{
+		GMalloc = this;
+	}
+
+	virtual ~FIniAllocationCounter() override
+	{
+		GMalloc = Inner;
+	}
+
+	/** Fresh blocks handed out, including reallocations that had to move or grow */
+	FORCEINLINE int64 GetNumAllocations() const { return NumAllocations; }
+
+	/** Bytes requested by those allocations */
+	FORCEINLINE int64 GetNumBytes() const { return NumBytes; }
+
+	FORCEINLINE void Reset()
+	{
+		NumAllocations = 0;
+		NumBytes = 0;
+	}
+
+public:
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		Record(Count);
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+	{
+		Record(Count);
+		return Inner->TryMalloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+			Record(Count);
+
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+			Record(Count);
+
+		return Inner->TryRealloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override { Inner->Free(Original); }
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("IniAllocationCounter"); }
+
+private:
+	FORCEINLINE void Record(SIZE_T Count)
+	{
+		if (FPlatformTLS::GetCurrentThreadId() != ThreadId)
+			return;
+
+		NumAllocations++;
+		NumBytes += static_cast<int64>(Count);
+	}
+
+	FMalloc* Inner;
+	uint32 ThreadId;
+	int64 NumAllocations = 0;
+	int64 NumBytes = 0;
+};
+
+namespace IniTestUtils
+{
+	/**
+	 * Synthetic document shaped like a game config: NumSections sections of NumProperties mixed scalar, vector and
+	 * quoted values, with a comment every few lines. The same arguments always give the same text.
+	 *
+	 * @param IN NumSections
+	 * @param IN NumProperties Per section
+	 * @param IN CommentEvery One comment line per this many properties, 0 for none
+	 * @return .ini text
+	 */
+	inline FString MakeCorpus(int32 NumSections, int32 NumProperties, int32 CommentEvery = 8)
+	{
+		TStringBuilder<4096> Builder;
+
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; SectionIndex++)
+		{
+			Builder.Appendf(TEXT("[/Script/Game.Section%d]\n"), SectionIndex);
+
+			for (int32 Index = 0; Index < NumProperties; Index++)
+			{
+				if (CommentEvery > 0 && Index % CommentEvery == 0)
+					Builder.Appendf(TEXT("; Settings block %d\n"), Index / CommentEvery);
+
+				switch (Index % 4)
+				{
+					case 0: Builder.Appendf(TEXT("Count%d=%d\n"), Index, Index * 37 - 500); break;
+					case 1: Builder.Appendf(TEXT("Scale%d=%.6g\n"), Index, Index * 0.125 + SectionIndex); break;
+					case 2: Builder.Appendf(TEXT("Offset%d=X=%d.5 Y=%d.25 Z=-%d\n"), Index, Index, SectionIndex, Index); break;
+					default: Builder.Appendf(TEXT("Name%d=\"Entry %d of section %d\"\n"), Index, Index, SectionIndex); break;
+				}
+			}
+
+			Builder.AppendChar(TEXT('\n'));
+		}
+
+		return FString(Builder.ToView());
+	}
+}
+
+#endif
\ No newline at end of file
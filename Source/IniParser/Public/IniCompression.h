@@ -0,0 +1,57 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+#include "IniCompression.generated.h"
+
+/* Codec used for compressed .ini files */
+UENUM(BlueprintType)
+enum class EIniCompressionFormat : uint8
+{
+	Zlib,
+	Gzip,
+	LZ4,
+	Oodle
+};
+
+/**
+ * Compressed .ini files: a small header (magic, codec, chunk size, chunk table) followed by independently compressed
+ * chunks of UTF-8 text. Reading decompresses one chunk at a time straight into the tokenizer, so the document never
+ * exists as a whole string in memory.
+ */
+struct INIPARSER_API FIniCompression
+{
+	/** "INIZ", little-endian */
+	static constexpr uint32 MAGIC = 0x5A494E49;
+	static constexpr uint8 VERSION = 1;
+
+	/** Uncompressed bytes per chunk */
+	static constexpr int32 CHUNK_SIZE = 256 * 1024;
+
+	/**
+	 * Read a compressed .ini file. Files without the header are parsed as plain text.
+	 *
+	 * @param IN FilePath
+	 * @param OUT OutData
+	 * @return True if the file was read and, if compressed, every chunk decoded
+	 */
+	static bool ReadFromFile(const FString& FilePath, FIniData& OutData);
+
+	/**
+	 * Write a compressed .ini file
+	 *
+	 * @param IN FilePath
+	 * @param IN Data
+	 * @param IN Format
+	 * @return True if the file was written
+	 */
+	static bool WriteToFile(const FString& FilePath, const FIniData& Data, EIniCompressionFormat Format);
+
+	/**
+	 * @param IN Format
+	 * @return Name of the codec for FCompression
+	 */
+	static FName GetFormatName(EIniCompressionFormat Format);
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/SharedPointer.h"
+#include "IniData.h"
+
+#include <atomic>
+
+/* Thread-safe .ini store. Writers publish immutable versions; readers hold snapshots that never change underneath them. Reads through an FReader are a single atomic load unless a new version was published since the reader's last refresh. */
+class INIPARSER_API FIniConcurrentStore
+{
+public:
+	typedef TSharedRef<const FIniData, ESPMode::ThreadSafe> FSnapshot;
+
+	/* Reader owned by one thread. Caches the latest snapshot and only refreshes it when the store version changes. */
+	class INIPARSER_API FReader
+	{
+	public:
+		explicit FReader(const FIniConcurrentStore& InStore);
+
+		/**
+		 * Get the latest published data.
+		 *
+		 * @return A reference that stays valid until the next call to Get on this reader.
+		 */
+		const FIniData& Get();
+
+	private:
+		const FIniConcurrentStore& Store;
+		FSnapshot Snapshot;
+		uint64 SnapshotVersion;
+	};
+
+public:
+	explicit FIniConcurrentStore(FIniData InitialData = FIniData());
+
+	/**
+	 * Publish a new version. Readers see either the previous or the new version, never a mix.
+	 *
+	 * @param IN NewData
+	 */
+	void Publish(FIniData NewData);
+
+	/**
+	 * Copy the current version, let the function edit the copy, and publish it. Concurrent updates and publishes are serialized,
+	 * so no edit is lost.
+	 *
+	 * @param IN Func Invoked as Func(FIniData& Data)
+	 * @return The version this update published, which later publishes from other threads do not change
+	 */
+	template <typename FuncType>
+	FSnapshot Update(FuncType&& Func)
+	{
+		FScopeLock Lock(&WriterLock);
+
+		FIniData Data = GetSnapshot().Get();
+		Func(Data);
+
+		FSnapshot Published = MakeSnapshot(MoveTemp(Data));
+		Exchange(Published);
+
+		return Published;
+	}
+
+	/**
+	 * Get the current version. Takes a short read lock; use FReader on hot paths.
+	 *
+	 * @return The latest snapshot.
+	 */
+	FSnapshot GetSnapshot() const;
+
+	/** Incremented on every publish */
+	FORCEINLINE uint64 GetVersion() const { return Version.load(std::memory_order_acquire); }
+
+private:
+	FSnapshot GetSnapshot(uint64& OutVersion) const;
+
+	// Materialize lazily loaded sections and wrap the data for sharing.
+	static FSnapshot MakeSnapshot(FIniData&& Data);
+
+	// Make a snapshot current. Must be called with WriterLock held.
+	void Exchange(FSnapshot NewSnapshot);
+
+	/** Guards swapping Current; only held for a pointer copy */
+	mutable FRWLock SnapshotLock;
+
+	/** Serializes Publish and Update, so an Update never overwrites a version published while it ran */
+	FCriticalSection WriterLock;
+
+	FSnapshot Current;
+	std::atomic<uint64> Version;
+};
\ No newline at end of file
@@ -6,6 +6,15 @@
 #include "IniSection.h"
 #include "IniData.generated.h"
 
+/* Byte range of one section body that has not been parsed yet, see UIniLibrary::ParseIniFromStringLazy */
+struct FIniLazySectionRange
+{
+	int32 Begin = 0;
+	int32 End = 0;
+	int32 NumProperties = 0;
+	int32 NumComments = 0;
+};
+
 USTRUCT(BlueprintType, meta = (HasNativeMake = "IniParser.IniLibrary.MakeIniData"))
 struct FIniData
 {
@@ -23,6 +32,34 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Details", meta = (AllowPrivateAccess = true))
 	TArray<FString> Comments;
 
+	/** How property keys are stored; set before the document is filled */
+	UPROPERTY(EditAnywhere, Category = "Details", meta = (AllowPrivateAccess = true))
+	EIniKeyMode KeyMode = EIniKeyMode::Name;
+
+	/** Global properties of an EIniKeyMode::CaseSensitive document */
+	FIniKeyTable KeyedProperties;
+
+	/**
+	 * Every keyed property of the document, global and per section, but only while it is serialized, exported or imported;
+	 * empty otherwise. The key tables themselves are not reflected.
+	 */
+	UPROPERTY()
+	TArray<FIniKeyedPropertyRecord> KeyedPropertyRecords;
+
+	/**
+	 * Source text of a lazily loaded document, shared by every copy until all sections are parsed.
+	 * Not reflected: copies made through reflection use the C++ copy, so they share it as well.
+	 */
+	TSharedPtr<const FString, ESPMode::ThreadSafe> LazySource;
+
+	/**
+	 * Sections that are still empty placeholders in Sections, and where their bodies are in LazySource.
+	 * Not reflected: Serialize and ExportTextItem materialize them before the reflected properties are written.
+	 */
+	TMap<FName, TArray<FIniLazySectionRange, TInlineAllocator<1>>> PendingSections;
+
+	friend struct FIniLazyIndexer;
+
 public:
 	FIniData()
 		: Sections()
@@ -31,49 +68,90 @@ public:
 	{ }
 
 	FIniData(TMap<FName, FIniSection> NewSections)
-		: Sections(NewSections)
+		: Sections(MoveTemp(NewSections))
 		, Properties()
 		, Comments()
 	{ }
 
 	FIniData(TMap<FName, FIniSection> NewSections, TMap<FName, FIniProperty> NewProperties)
-		: Sections(NewSections)
-		, Properties(NewProperties)
+		: Sections(MoveTemp(NewSections))
+		, Properties(MoveTemp(NewProperties))
 		, Comments()
 	{ }
 
 	FIniData(TMap<FName, FIniSection> NewSections, TMap<FName, FIniProperty> NewProperties, TArray<FString> NewComments)
-		: Sections(NewSections)
-		, Properties(NewProperties)
-		, Comments(NewComments)
+		: Sections(MoveTemp(NewSections))
+		, Properties(MoveTemp(NewProperties))
+		, Comments(MoveTemp(NewComments))
 	{ }
 
 	FIniData(TMap<FName, FIniSection> NewSections, TArray<FString> NewComments)
-		: Sections(NewSections)
+		: Sections(MoveTemp(NewSections))
 		, Properties()
-		, Comments(NewComments)
+		, Comments(MoveTemp(NewComments))
 	{ }
 
 	FIniData(TArray<FString> NewComments)
 		: Sections()
 		, Properties()
-		, Comments(NewComments)
+		, Comments(MoveTemp(NewComments))
 	{ }
 
 public:
 	FORCEINLINE int32 GetNumOfSections() const { return Sections.Num(); }
 	FORCEINLINE int32 GetNumOfComments() const { return Comments.Num(); }
-	FORCEINLINE int32 GetNumOfProperties() const { return Properties.Num(); }
-	FORCEINLINE TArray<FString> GetComments() const { return Comments; }
-	FORCEINLINE TMap<FName, FIniProperty> GetProperties() const { return Properties; }
-	FORCEINLINE TMap<FName, FIniSection> GetSections() const { return Sections; }
+	FORCEINLINE int32 GetNumOfProperties() const { return Properties.Num() + KeyedProperties.Num(); }
+	FORCEINLINE const TArray<FString>& GetComments() const { return Comments; }
+	FORCEINLINE const TMap<FName, FIniProperty>& GetProperties() const { return Properties; }
+	FORCEINLINE const FIniKeyTable& GetKeyedProperties() const { return KeyedProperties; }
+	FORCEINLINE FIniKeyTable& GetKeyedProperties() { return KeyedProperties; }
+	FORCEINLINE EIniKeyMode GetKeyMode() const { return KeyMode; }
+	FORCEINLINE void SetKeyMode(EIniKeyMode NewKeyMode) { KeyMode = NewKeyMode; }
 	FORCEINLINE bool HasComment(const FString& Comment) const { return Comments.Contains(Comment); }
 	FORCEINLINE bool HasSection(const FName& SectionName) const { return Sections.Contains(SectionName); }
 	FORCEINLINE bool HasEmptyComments() const { return Comments.IsEmpty(); }
 	FORCEINLINE bool HasEmptySections() const { return Sections.IsEmpty(); }
-	FORCEINLINE bool HasEmptyProperties() const { return Properties.IsEmpty(); }
+	FORCEINLINE bool HasEmptyProperties() const { return Properties.IsEmpty() && KeyedProperties.IsEmpty(); }
+	FORCEINLINE bool HasPendingSections() const { return !PendingSections.IsEmpty(); }
+
+	/**
+	 * Get every section. Sections of a lazily loaded document are parsed first.
+	 * Not thread-safe while HasPendingSections() is true, call Materialize before sharing the data between threads.
+	 *
+	 * @return All sections
+	 */
+	FORCEINLINE const TMap<FName, FIniSection>& GetSections() const
+	{
+		if (HasPendingSections())
+			const_cast<FIniData*>(this)->Materialize();
+
+		return Sections;
+	}
 
 public:
+	/**
+	 * Preallocate memory for sections and global properties, so the maps do not grow while being filled.
+	 * Global properties are reserved in the container that matches the key mode.
+	 *
+	 * @param IN NumSections
+	 * @param IN NumProperties
+	 * @param IN NumComments
+	 */
+	void Reserve(int32 NumSections, int32 NumProperties, int32 NumComments);
+
+	/**
+	 * Parse every section of a lazily loaded document that has not been touched yet. Does nothing for eagerly parsed data.
+	 */
+	void Materialize();
+
+	/**
+	 * Whether the document is EIniKeyMode::CaseSensitive or holds any keyed property. Such documents can not be represented by
+	 * APIs that name properties by FName (FIniPatch, FIniLayerStack, FIniQuery, FIniSchema), which refuse them.
+	 *
+	 * @return True if any property is stored under a case-sensitive key
+	 */
+	bool HasKeyedProperties() const;
+
 	/**
 	 * Find .ini section associated with a specified name.
 	 *
@@ -107,6 +185,15 @@ public:
 	 */
 	FIniSection& AddSection(const FName& Key);
 
+	/**
+	 * Add an existing .ini section by moving it into the document
+	 *
+	 * @param IN Key The key to associate the value with.
+	 * @param IN Section The section to move in.
+	 * @return A reference of .ini section. The reference is only valid until the next change to any key in the map.
+	 */
+	FIniSection& AddSection(const FName& Key, FIniSection&& Section);
+
 	/**
 	 * Get a .ini section based on the name.
 	 *
@@ -115,6 +202,14 @@ public:
 	 */
 	FIniSection& GetSection(const FName& SectionName);
 
+	/**
+	 * Remove a .ini section and all of its properties and comments.
+	 *
+	 * @param IN SectionName The name to search for.
+	 * @return True if a section was removed.
+	 */
+	bool RemoveSection(const FName& SectionName);
+
 	/**
 	 * Add global comment
 	 *
@@ -129,6 +224,14 @@ public:
 	 */
 	void AddUniqueComment(FString Comment);
 
+	/**
+	 * Remove the first matching global comment
+	 *
+	 * @param IN Comment
+	 * @return True if a comment was removed.
+	 */
+	bool RemoveComment(const FString& Comment);
+
 	/**
 	 * Find a global property
 	 *
@@ -137,6 +240,32 @@ public:
 	 */
 	FIniProperty* FindProperty(const FName& Key);
 
+	/**
+	 * Find a global property by its key text: case-sensitively among the keyed properties first, then among the FName properties.
+	 * Never adds to the global name table.
+	 *
+	 * @param IN Key
+	 * @return A pointer to the property, or nullptr
+	 */
+	FIniProperty* FindPropertyByString(FStringView Key);
+
+	/**
+	 * Find a case-sensitive keyed global property, or add one with the given value
+	 *
+	 * @param IN Key
+	 * @param IN Value Used only if the key is new
+	 * @return A reference to the property. The reference is only valid until the next change to the keyed properties.
+	 */
+	FIniProperty& FindOrAddKeyedProperty(FStringView Key, FString&& Value);
+
+	/**
+	 * Remove a case-sensitive keyed global property
+	 *
+	 * @param IN Key
+	 * @return True if a property was removed.
+	 */
+	bool RemoveKeyedProperty(FStringView Key);
+
 	/**
 	 * Find .ini property associated with a specified name.
 	 *
@@ -154,6 +283,15 @@ public:
 	 */
 	FIniProperty& FindOrAddProperty(const FName& Key, const FString& Value);
 
+	/**
+	 * Find or add a global property, moving the value in if the property is added
+	 *
+	 * @param IN Key The name to search for.
+	 * @param IN Value The value to add to .ini property
+	 * @return A reference to the .ini property associated with the specified name.
+	 */
+	FIniProperty& FindOrAddProperty(const FName& Key, FString&& Value);
+
 	/**
 	 * Add a global property
 	 *
@@ -163,6 +301,15 @@ public:
 	 */
 	FIniProperty& AddProperty(const FName& Key, const FString& Value);
 
+	/**
+	 * Add a global property, moving the value in
+	 *
+	 * @param IN Key The name to search for.
+	 * @param IN Value The value to add to .ini property
+	 * @return A reference to the newly created .ini property
+	 */
+	FIniProperty& AddProperty(const FName& Key, FString&& Value);
+
 	/**
 	 * Get a .ini property based on the name.
 	 *
@@ -171,6 +318,85 @@ public:
 	 */
 	FIniProperty& GetProperty(const FName& PropertyName);
 
+	/**
+	 * Remove a global property
+	 *
+	 * @param IN PropertyName The name to search for.
+	 * @return True if a property was removed.
+	 */
+	bool RemoveProperty(const FName& PropertyName);
+
+	/**
+	 * Move all sections out of the document, leaving it without sections.
+	 *
+	 * @return The sections that were stored in the document.
+	 */
+	TMap<FName, FIniSection> ExtractSections();
+
+	/**
+	 * Move all global properties out of the document, leaving it without global properties.
+	 *
+	 * @return The global properties that were stored in the document.
+	 */
+	TMap<FName, FIniProperty> ExtractProperties();
+
+	/**
+	 * Move all global comments out of the document, leaving it without global comments.
+	 *
+	 * @return The global comments that were stored in the document.
+	 */
+	TArray<FString> ExtractComments();
+
 public:
 	FIniSection& operator[](const FName& SectionName);
+
+	/**
+	 * Reflection serializer. Parses pending sections and copies the key tables into KeyedPropertyRecords before saving,
+	 * so the tagged properties hold the whole document, and drops the lazy state before loading so it can not overwrite
+	 * the loaded sections later.
+	 *
+	 * @return Always false, the reflected properties are serialized as usual
+	 */
+	bool Serialize(FArchive& Ar);
+
+	/**
+	 * Rebuild the key tables from KeyedPropertyRecords after loading, and empty the records again after saving.
+	 */
+	void PostSerialize(const FArchive& Ar);
+
+	/**
+	 * Reflection text export, used by copy and paste and text exports. Parses pending sections and exports the keyed properties with the rest.
+	 *
+	 * @return Always true
+	 */
+	bool ExportTextItem(FString& ValueStr, const FIniData& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
+
+	/**
+	 * Reflection text import, the counterpart of ExportTextItem. Rebuilds the key tables from the imported records.
+	 *
+	 * @return False if the text could not be imported
+	 */
+	bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
+
+private:
+	// Parse the body of a pending section into its placeholder.
+	void MaterializeSection(const FName& SectionName);
+
+	// Copy every key table into KeyedPropertyRecords.
+	void StoreKeyedProperties();
+
+	// Replace every key table with the contents of KeyedPropertyRecords, then empty the records.
+	void RestoreKeyedProperties();
+};
+
+template<>
+struct TStructOpsTypeTraits<FIniData> : public TStructOpsTypeTraitsBase2<FIniData>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithPostSerialize = true,
+		WithExportTextItem = true,
+		WithImportTextItem = true,
+	};
 };
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniDiagnostic.generated.h"
+
+UENUM(BlueprintType)
+enum class EIniDiagnosticSeverity : uint8
+{
+	/** The line was parsed, but part of it was ignored or overrides nothing */
+	Warning,
+
+	/** The line was dropped */
+	Error
+};
+
+/* A problem found while parsing, see UIniLibrary::ParseIniFromStringWithDiagnostics */
+USTRUCT(BlueprintType)
+struct FIniDiagnostic
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	EIniDiagnosticSeverity Severity = EIniDiagnosticSeverity::Error;
+
+	/** 1-based */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	int32 Line = 0;
+
+	/** 1-based, in characters */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	int32 Column = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FString Message;
+
+	FIniDiagnostic() = default;
+
+	FIniDiagnostic(EIniDiagnosticSeverity InSeverity, int32 InLine, int32 InColumn, FString InMessage)
+		: Severity(InSeverity)
+		, Line(InLine)
+		, Column(InColumn)
+		, Message(MoveTemp(InMessage))
+	{ }
+};
\ No newline at end of file
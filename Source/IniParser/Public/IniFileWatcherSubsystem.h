@@ -0,0 +1,107 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "IniData.h"
+#include "IniFileWatcherSubsystem.generated.h"
+
+struct FFileChangeData;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnIniFileReloaded, const FString&, FilePath, const FIniData&, Data);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnIniSectionChanged, const FString&, FilePath, FName, SectionName);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnIniPropertyChanged, const FString&, FilePath, FName, SectionName, FName, PropertyName);
+
+/* Keeps loaded .ini files up to date. Changed files are re-parsed on a worker thread, compared against the previous data, and only the sections/properties that differ are broadcast on the game thread. Editor builds are notified by the directory watcher; other targets poll file timestamps on a worker thread, so a change is noticed up to POLL_INTERVAL seconds late. */
+UCLASS()
+class INIPARSER_API UIniFileWatcherSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Fired after a watched file was re-parsed and at least one value changed. */
+	UPROPERTY(BlueprintAssignable, Category = "IniParser|FileWatcher")
+	FOnIniFileReloaded OnFileReloaded;
+
+	/** Fired once per section that was added, removed or edited. Global properties report NAME_None. */
+	UPROPERTY(BlueprintAssignable, Category = "IniParser|FileWatcher")
+	FOnIniSectionChanged OnSectionChanged;
+
+	/** Fired once per property that was added, removed or edited. Global properties report NAME_None as section. */
+	UPROPERTY(BlueprintAssignable, Category = "IniParser|FileWatcher")
+	FOnIniPropertyChanged OnPropertyChanged;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Read a file and keep watching it for changes.
+	 *
+	 * @param IN FilePath
+	 * @return The current .ini data of the file.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IniParser|FileWatcher")
+	FIniData WatchFile(const FString& FilePath);
+
+	/**
+	 * Stop watching a file.
+	 *
+	 * @param IN FilePath
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IniParser|FileWatcher")
+	void UnwatchFile(const FString& FilePath);
+
+	/**
+	 * Get the latest data of a watched file.
+	 *
+	 * @param IN FilePath
+	 * @param OUT OutData
+	 * @return False if the file is not watched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IniParser|FileWatcher")
+	bool GetWatchedData(const FString& FilePath, FIniData& OutData) const;
+
+private:
+	struct FWatchedFile
+	{
+		/* Shared so broadcasts can keep the data alive while listeners unwatch files */
+		TSharedRef<const FIniData> Data = MakeShared<FIniData>();
+		FDateTime TimeStamp;
+		bool bReloadPending = false;
+
+		/* Changed again while the reload was in flight */
+		bool bReloadAgain = false;
+	};
+
+	/** Seconds between timestamp checks when no directory watcher is available */
+	static constexpr float POLL_INTERVAL = 1.0f;
+
+	TMap<FString, FWatchedFile> WatchedFiles;
+
+	/** Directory watcher registrations, keyed by directory */
+	TMap<FString, FDelegateHandle> DirectoryHandles;
+
+	FTSTicker::FDelegateHandle PollHandle;
+
+	bool bUseDirectoryWatcher = false;
+
+	/** True while a worker thread checks the timestamps */
+	bool bPollPending = false;
+
+private:
+	static FString NormalizePath(const FString& FilePath);
+
+	bool Poll(float DeltaTime);
+	void FinishPoll(const TArray<FString>& ChangedFiles);
+	void OnDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+	void WatchDirectory(const FString& Directory);
+	void UnwatchDirectory(const FString& Directory);
+
+	void RequestReload(const FString& FilePath);
+	void FinishReload(const FString& FilePath, FIniData&& NewData, const FDateTime& TimeStamp);
+	void BroadcastChanges(const FString& FilePath, const FIniData& OldData, const FIniData& NewData);
+};
\ No newline at end of file
@@ -0,0 +1,123 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniProperty.h"
+#include "IniKeyTable.generated.h"
+
+/* How a document stores property keys */
+UENUM(BlueprintType)
+enum class EIniKeyMode : uint8
+{
+	/** Interned FName keys, compared case-insensitively (default) */
+	Name,
+
+	/** Case-sensitive keys kept in the document, see FIniKeyTable. They never enter the global FName table. */
+	CaseSensitive,
+};
+
+/* Property stored under a case-sensitive key, with the key's hash beside it */
+struct FIniKeyedProperty
+{
+	FString Key;
+	uint64 Hash = 0;
+	FIniProperty Property;
+
+	/** Next entry with the same 64-bit hash, or INDEX_NONE */
+	int32 NextWithSameHash = INDEX_NONE;
+};
+
+/* A keyed property as written to assets and copied text. FIniData only fills these while it is serialized or exported. */
+USTRUCT()
+struct FIniKeyedPropertyRecord
+{
+	GENERATED_BODY()
+
+	/** True for a global property; Section is unused then */
+	UPROPERTY()
+	bool bGlobal = false;
+
+	UPROPERTY()
+	FName Section;
+
+	UPROPERTY()
+	FString Key;
+
+	UPROPERTY()
+	FIniProperty Property;
+};
+
+/**
+ * Properties under case-sensitive keys, for documents whose keys must not be folded or interned (e.g. imported configs with
+ * millions of one-off keys). Entries are stored contiguously in insertion order (until a removal) with a precomputed CityHash64 of the key,
+ * so a lookup hashes the key once and compares strings only on a full 64-bit match.
+ */
+class INIPARSER_API FIniKeyTable
+{
+public:
+	/**
+	 * Hash a key the way the table does, for callers that look the same key up repeatedly
+	 *
+	 * @param IN Key
+	 * @return 64-bit hash of the key's characters
+	 */
+	static uint64 HashKey(FStringView Key);
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+	FORCEINLINE bool IsEmpty() const { return Entries.IsEmpty(); }
+	FORCEINLINE const TArray<FIniKeyedProperty>& GetEntries() const { return Entries; }
+
+	/**
+	 * Preallocate memory for entries and the index
+	 *
+	 * @param IN NumEntries
+	 */
+	void Reserve(int32 NumEntries);
+
+	/**
+	 * Find a property
+	 *
+	 * @param IN Key Compared case-sensitively
+	 * @param IN Hash HashKey(Key)
+	 * @return The property, or nullptr
+	 */
+	FIniProperty* Find(FStringView Key, uint64 Hash);
+
+	FORCEINLINE FIniProperty* Find(FStringView Key) { return Find(Key, HashKey(Key)); }
+
+	const FIniProperty* Find(FStringView Key, uint64 Hash) const;
+
+	FORCEINLINE const FIniProperty* Find(FStringView Key) const { return Find(Key, HashKey(Key)); }
+
+	/**
+	 * Find a property, or add one with the given value
+	 *
+	 * @param IN Key Compared case-sensitively
+	 * @param IN Value Used only if the key is new
+	 * @return The property. The reference is only valid until the next change to the table.
+	 */
+	FIniProperty& FindOrAdd(FStringView Key, FString&& Value);
+
+	/**
+	 * Remove a property in constant time. The last entry moves into its slot, so entries are no longer in insertion order.
+	 *
+	 * @param IN Key Compared case-sensitively
+	 * @return True if a property was removed
+	 */
+	bool Remove(FStringView Key);
+
+	void Reset();
+
+private:
+	TArray<FIniKeyedProperty> Entries;
+
+	/** Hash -> first entry with that hash */
+	TMap<uint64, int32> Index;
+
+private:
+	int32 FindIndex(FStringView Key, uint64 Hash) const;
+
+	/** The index slot or NextWithSameHash that holds EntryIndex */
+	int32& FindLink(uint64 Hash, int32 EntryIndex);
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+
+/* Ordered stack of .ini layers (e.g. defaults -> platform -> user) served through a flattened lookup index. Later layers override earlier ones. Reads are a single hash lookup regardless of the number of layers; replacing a layer only re-resolves the keys that layer changed. */
+class INIPARSER_API FIniLayerStack
+{
+public:
+	/**
+	 * Push a layer on top of the stack.
+	 *
+	 * @param IN Data Must not have case-sensitive keys (see FIniData::HasKeyedProperties)
+	 * @return Index of the new layer, or INDEX_NONE if the layer has case-sensitive keys.
+	 */
+	int32 AddLayer(FIniData Data);
+
+	/**
+	 * Replace a layer. Only keys that differ between the old and new layer are re-resolved.
+	 *
+	 * @param IN LayerIndex
+	 * @param IN Data Must not have case-sensitive keys; such a layer is refused and the old one is kept
+	 */
+	void SetLayer(int32 LayerIndex, FIniData Data);
+
+	/**
+	 * Get a layer for reading.
+	 *
+	 * @param IN LayerIndex
+	 * @return A reference to the layer.
+	 */
+	const FIniData& GetLayer(int32 LayerIndex) const;
+
+	FORCEINLINE int32 GetNumOfLayers() const { return Layers.Num(); }
+
+	/**
+	 * Find the effective value of a property.
+	 *
+	 * @param IN SectionName NAME_None for global properties.
+	 * @param IN PropertyName
+	 * @return A pointer to the property in the highest layer that defines it, or nullptr. Valid until the stack changes.
+	 */
+	const FIniProperty* FindProperty(const FName& SectionName, const FName& PropertyName) const;
+
+	/**
+	 * Find which layer provides a property.
+	 *
+	 * @param IN SectionName NAME_None for global properties.
+	 * @param IN PropertyName
+	 * @return The layer index, or INDEX_NONE if no layer defines the property.
+	 */
+	int32 FindLayerOfProperty(const FName& SectionName, const FName& PropertyName) const;
+
+	/**
+	 * Build a standalone document with every effective property.
+	 *
+	 * @return The merged .ini data.
+	 */
+	FIniData Flatten() const;
+
+private:
+	struct FKey
+	{
+		FName Section;
+		FName Property;
+
+		FORCEINLINE bool operator==(const FKey& Other) const { return Section == Other.Section && Property == Other.Property; }
+
+		friend FORCEINLINE uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Section), GetTypeHash(Key.Property));
+		}
+	};
+
+	TArray<FIniData> Layers;
+
+	/** Effective layer index for every key defined in any layer */
+	TMap<FKey, int32> Index;
+
+private:
+	static const FIniProperty* FindInLayer(const FIniData& Layer, const FKey& Key);
+
+	// Resolve a key from the top of the stack down.
+	void Resolve(const FKey& Key);
+
+	template <typename FuncType>
+	static void ForEachKey(const FIniData& Layer, FuncType&& Func);
+};
\ No newline at end of file
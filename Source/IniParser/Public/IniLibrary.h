@@ -7,6 +7,10 @@
 #include "IniData.h"
 #include "IniProperty.h"
 #include "IniSection.h"
+#include "IniPatch.h"
+#include "IniCompression.h"
+#include "IniDiagnostic.h"
+#include "IniSchema.h"
 #include "IniLibrary.generated.h"
 
 UCLASS()
@@ -28,6 +32,21 @@ public:
 	)
 	static FIniData ParseIniFromString(FString String);
 
+	/**
+	 * Parse .ini from a string, choosing how property keys are stored. EIniKeyMode::CaseSensitive keeps keys out of the
+	 * global FName table, for documents with many one-off keys; read them with FindPropertyByString or "Get Property Value As String By Key".
+	 *
+	 * @param String Only accept .ini style format. Read more about here: https://en.wikipedia.org/wiki/INI
+	 * @param KeyMode
+	 * @return .ini data, populated from the string.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From String (Key Mode)")
+	)
+	static FIniData ParseIniFromStringWithKeyMode(FString String, EIniKeyMode KeyMode);
+
 	/**
 	 * .ini to a string
 	 *
@@ -54,6 +73,96 @@ public:
 	)
 	static FIniData ReadIniFromFile(FString FilePath);
 
+	/**
+	 * Read .Ini From File, choosing how property keys are stored
+	 *
+	 * @param FilePath
+	 * @param KeyMode See ParseIniFromStringWithKeyMode
+	 * @return A new instance of ini data
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From File (Key Mode)")
+	)
+	static FIniData ReadIniFromFileWithKeyMode(FString FilePath, EIniKeyMode KeyMode);
+
+	/**
+	 * Parse .ini from a string, but only locate the sections. A section is parsed the first time it is looked up
+	 * (FindSection, GetSection, the section getters of this library, ...), so unused sections cost almost nothing.
+	 *
+	 * @param String Only accept .ini style format. Read more about here: https://en.wikipedia.org/wiki/INI
+	 * @param KeyMode See ParseIniFromStringWithKeyMode. Pending sections are parsed with the same mode.
+	 * @return .ini data, with global entries parsed and every section pending.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From String (Lazy)")
+	)
+	static FIniData ParseIniFromStringLazy(FString String, EIniKeyMode KeyMode = EIniKeyMode::Name);
+
+	/**
+	 * Parse .ini from a string and report every malformed line (missing ']', missing '=', empty key)
+	 * and suspicious one (text after ']', duplicate key). The data is the same as ParseIniFromString returns.
+	 *
+	 * @param String Only accept .ini style format. Read more about here: https://en.wikipedia.org/wiki/INI
+	 * @param OutDiagnostics Problems in source order, with line and column
+	 * @param KeyMode See ParseIniFromStringWithKeyMode. Duplicate keys are compared the same way, so case-sensitive keys that differ only in case are not duplicates.
+	 * @return .ini data, populated from the string.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From String (Diagnostics)")
+	)
+	static FIniData ParseIniFromStringWithDiagnostics(FString String, TArray<FIniDiagnostic>& OutDiagnostics, EIniKeyMode KeyMode = EIniKeyMode::Name);
+
+	/**
+	 * Read .Ini from file and report malformed lines. See ParseIniFromStringWithDiagnostics.
+	 *
+	 * @param FilePath
+	 * @param OutDiagnostics Problems in source order, with line and column
+	 * @param KeyMode See ParseIniFromStringWithKeyMode
+	 * @return A new instance of ini data
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From File (Diagnostics)")
+	)
+	static FIniData ReadIniFromFileWithDiagnostics(FString FilePath, TArray<FIniDiagnostic>& OutDiagnostics, EIniKeyMode KeyMode = EIniKeyMode::Name);
+
+	/**
+	 * Validate .ini data against a schema document (see FIniSchema for the syntax).
+	 * Compiles the schema on every call; C++ users validating many documents should keep a compiled FIniSchema.
+	 *
+	 * @param Data
+	 * @param Schema
+	 * @param OutViolations Every violation, plus one per schema rule that failed to compile
+	 * @return True if the data is valid
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Validate .Ini")
+	)
+	static bool ValidateIni(const FIniData& Data, const FIniData& Schema, TArray<FIniSchemaViolation>& OutViolations);
+
+	/**
+	 * Read .Ini from file, parsing each section on first use. See ParseIniFromStringLazy.
+	 *
+	 * @param FilePath
+	 * @param KeyMode See ParseIniFromStringWithKeyMode
+	 * @return A new instance of ini data
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From File (Lazy)")
+	)
+	static FIniData ReadIniFromFileLazy(FString FilePath, EIniKeyMode KeyMode = EIniKeyMode::Name);
+
 	/**
 	 * Write .Ini From File
 	 *
@@ -67,6 +176,48 @@ public:
 	)
 	static void WriteIniToFile(FString FilePath, const FIniData& Data);
 
+	/**
+	 * Read a compressed .ini file written by WriteIniToCompressedFile. The codec is taken from the file header,
+	 * and files without that header are read as plain text.
+	 *
+	 * @param FilePath
+	 * @return A new instance of ini data
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Parse .Ini From Compressed File")
+	)
+	static FIniData ReadIniFromCompressedFile(FString FilePath);
+
+	/**
+	 * Write .ini data as a compressed file
+	 *
+	 * @param FilePath
+	 * @param Data
+	 * @param Format Codec to compress with
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Write .Ini To Compressed File")
+	)
+	static void WriteIniToCompressedFile(FString FilePath, const FIniData& Data, EIniCompressionFormat Format = EIniCompressionFormat::Zlib);
+
+	/**
+	 * Pack every .ini file below a directory into one file, see FIniPack
+	 *
+	 * @param Directory
+	 * @param OutputPath
+	 * @return True if the pack was written
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary",
+		meta = (DisplayName = "Build .Ini Pack")
+	)
+	static bool BuildIniPack(FString Directory, FString OutputPath);
+
 	/**
 	 * Get number of sections from .ini data
 	 *
@@ -192,6 +343,33 @@ public:
 		CompactNodeTitle = "->", BlueprintAutocast))
 	static FString Conv_IniDataToString(const FIniData& Data);
 
+	/**
+	 * Compute the structural difference between two .ini documents.
+	 * Parses the pending sections of lazily loaded documents, so it is not thread-safe.
+	 *
+	 * @param IN From The original document
+	 * @param IN To The changed document
+	 * @return A patch of added/removed/changed sections, properties and comments
+	 */
+	UFUNCTION(
+		BlueprintPure,
+		Category = "IniParser|IniLibrary"
+	)
+	static FIniPatch ComputeDiff(const FIniData& From, const FIniData& To);
+
+	/**
+	 * Apply a patch to .ini data in place
+	 *
+	 * @param IN Data
+	 * @param IN Patch
+	 * @return False if the data has case-sensitive keys, which patches can not address; the data is left unchanged
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary"
+	)
+	static bool ApplyPatch(UPARAM(ref) FIniData& Data, const FIniPatch& Patch);
+
 public:
 	/**
 	 * Get global property value as Name type
@@ -229,6 +407,19 @@ public:
 	)
 	static void GetGlobalPropertyValueAsString(UPARAM(ref) FIniData& Data, FName PropertyName, FString& OutValue);
 
+	/**
+	 * Get global property value as an array ("+Key=..." lines). A plain value is returned as a single element.
+	 *
+	 * @param IN Data
+	 * @param IN PropertyName
+	 * @param OUT OutValues
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary"
+	)
+	static void GetGlobalPropertyValueAsArray(UPARAM(ref) FIniData& Data, FName PropertyName, TArray<FString>& OutValues);
+
 	/**
 	 * Get global property value as int32 type
 	 *
@@ -380,6 +571,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "IniParser|IniLibrary")
 	static void SetGlobalPropertyValueAsString(UPARAM(ref) FIniData& Data, FName PropertyName, FString NewValue);
 
+	/**
+	 * Set global property value as an array, written as one "+Key=..." line per element
+	 *
+	 * @param IN Data
+	 * @param IN PropertyName
+	 * @param IN NewValues
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IniParser|IniLibrary")
+	static void SetGlobalPropertyValueAsArray(UPARAM(ref) FIniData& Data, FName PropertyName, TArray<FString> NewValues);
+
 	/**
 	 * Set global property value as Object type
 	 *
@@ -603,6 +804,35 @@ public:
 	)
 	static void GetPropertyValueAsString(UPARAM(ref) FIniData& Data, FName SectionName, FName PropertyName, FString& Value);
 
+	/**
+	 * Get property value as an array ("+Key=..." lines). A plain value is returned as a single element.
+	 *
+	 * @param IN Data
+	 * @param IN SectionName
+	 * @param IN PropertyName
+	 * @param OUT OutValues
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary"
+	)
+	static void GetPropertyValueAsArray(UPARAM(ref) FIniData& Data, FName SectionName, FName PropertyName, TArray<FString>& OutValues);
+
+	/**
+	 * Get property value as String type, looked up by key text. Finds case-sensitive keys and never adds to the global name table.
+	 *
+	 * @param IN Data
+	 * @param IN SectionName None for a global property
+	 * @param IN Key
+	 * @param OUT OutValue
+	 * @return True if the property was found
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "IniParser|IniLibrary"
+	)
+	static bool GetPropertyValueAsStringByKey(UPARAM(ref) FIniData& Data, FName SectionName, FString Key, FString& OutValue);
+
 	/**
 	 * Get property value as int32 type
 	 *
@@ -777,6 +1007,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "IniParser|IniLibrary")
 	static void SetPropertyValueAsString(UPARAM(ref) FIniData& Data, FName SectionName, FName PropertyName, FString NewValue);
 
+	/**
+	 * Set property value as an array, written as one "+Key=..." line per element
+	 *
+	 * @param IN Data
+	 * @param IN SectionName
+	 * @param IN PropertyName
+	 * @param IN NewValues
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IniParser|IniLibrary")
+	static void SetPropertyValueAsArray(UPARAM(ref) FIniData& Data, FName SectionName, FName PropertyName, TArray<FString> NewValues);
+
 	/**
 	 * Set property value as Object type
 	 *
@@ -974,21 +1215,4 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "IniParser|IniLibrary")
 	static void SetPropertyValueAsPlatformUserId(UPARAM(ref) FIniData& Data, FName SectionName, FName PropertyName, FPlatformUserId NewValue);
-
-private:
-	/**
-	 * Append character to buffer
-	 *
-	 * @param IN Buffer
-	 * @param OUT Char
-	 */
-	static void AppendBuffer(char* Buffer, char Char);
-
-	/**
-	 * Trim the buffer (removes space and tab characters).
-	 *
-	 * @param IN Buffer
-	 * @param OUT Value
-	 */
-	static void TrimBuffer(char* Buffer);
-};
+};
\ No newline at end of file
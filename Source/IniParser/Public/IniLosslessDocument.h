@@ -0,0 +1,129 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+#include "Misc/FileHelper.h"
+
+/**
+ * .ini document that keeps its source text, so saving reproduces the file byte for byte except for what was edited.
+ * Edits are made on GetData() as usual. At save time the data is diffed against the loaded snapshot and only the changed
+ * lines are rewritten; blank lines, ordering, spacing, quote style and line endings of everything else are kept.
+ * The snapshot is taken the first time the data is handed out for editing, so a document that was only read saves its source as is.
+ */
+class INIPARSER_API FIniLosslessDocument
+{
+public:
+	FIniLosslessDocument() = default;
+
+	/**
+	 * Parse a document
+	 *
+	 * @param IN Source
+	 */
+	explicit FIniLosslessDocument(FString Source);
+
+	/**
+	 * Load a document, remembering its text encoding for SaveToFile
+	 *
+	 * @param IN FilePath
+	 * @param OUT OutDocument
+	 * @return True if the file was read
+	 */
+	static bool LoadFromFile(const FString& FilePath, FIniLosslessDocument& OutDocument);
+
+	/**
+	 * Data for editing. The first call takes the snapshot that edits are diffed against, use the const overload to only read.
+	 *
+	 * @return The document data
+	 */
+	FIniData& GetData();
+
+	FORCEINLINE const FIniData& GetData() const { return Data; }
+	FORCEINLINE const FString& GetSource() const { return Source; }
+
+	/**
+	 * @return True if the data differs from what was loaded
+	 */
+	bool IsModified() const;
+
+	/**
+	 * Produce the document text. Returns the source unchanged if nothing was edited.
+	 *
+	 * @return The document text
+	 */
+	FString ToString() const;
+
+	/**
+	 * Write the document with the encoding it was loaded with, then treat the written text as the new source.
+	 *
+	 * @param IN FilePath
+	 * @return True if the file was written
+	 */
+	bool SaveToFile(const FString& FilePath);
+
+private:
+	/* Where a section's lines are; a section can be split over several headers */
+	struct FSectionLayout
+	{
+		/** [header line, next header line) of each block */
+		TArray<TPair<int32, int32>, TInlineAllocator<1>> Blocks;
+
+		/** Offset after the last entry line, where new entries go */
+		int32 InsertAt = 0;
+	};
+
+	struct FLineLayout
+	{
+		int32 LineBegin = 0;
+
+		/** After the newline, if any */
+		int32 LineEnd = 0;
+
+		/** Raw value of a property, or text of a comment */
+		int32 TextBegin = 0;
+		int32 TextEnd = 0;
+
+		/** Property lines only: "+Key=..." or "-Key=..." */
+		bool bArrayOp = false;
+	};
+
+	struct FKey
+	{
+		FName Section;
+		FName Property;
+
+		FORCEINLINE bool operator==(const FKey& Other) const { return Section == Other.Section && Property == Other.Property; }
+
+		friend FORCEINLINE uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Section), GetTypeHash(Key.Property));
+		}
+	};
+
+	FString Source;
+
+	FIniData Data;
+
+	/** Data as loaded, diffed against Data at save time; only taken once bDataExposed is set */
+	FIniData Snapshot;
+
+	/** Data was handed out for editing; until then it still matches Source */
+	bool bDataExposed = false;
+
+	/** NAME_None is the global scope */
+	TMap<FName, FSectionLayout> Sections;
+	/** First plain definition of each property, followed by its array operation lines */
+	TMap<FKey, TArray<FLineLayout, TInlineAllocator<1>>> Properties;
+	TMap<FName, TArray<FLineLayout>> Comments;
+
+	bool bCRLF = false;
+
+	FFileHelper::EEncodingOptions Encoding = FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM;
+
+	friend struct FIniLosslessIndexer;
+
+private:
+	void Parse(FString NewSource);
+};
\ No newline at end of file
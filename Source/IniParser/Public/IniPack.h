@@ -0,0 +1,114 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Many .ini documents packed into one file: a header, a table of contents sorted by path hash, then the UTF-8 documents back to back.
+ * Opening a pack reads only the header and the table (one file open); each document is then parsed on demand, straight from a
+ * memory mapping of the pack when the platform supports it.
+ *
+ * Paths are relative to the packed directory and compared case-insensitively with '/' as separator.
+ */
+class INIPARSER_API FIniPack
+{
+public:
+	/** "INIP", little-endian */
+	static constexpr uint32 MAGIC = 0x50494E49;
+	static constexpr uint32 VERSION = 1;
+
+	/**
+	 * Pack every matching file below a directory
+	 *
+	 * @param IN Directory
+	 * @param IN OutputPath
+	 * @param IN Wildcard
+	 * @return True if the pack was written
+	 */
+	static bool Build(const FString& Directory, const FString& OutputPath, const FString& Wildcard = TEXT("*.ini"));
+
+	/**
+	 * @param IN RelativePath
+	 * @return The table of contents key of a path
+	 */
+	static uint64 HashPath(const FString& RelativePath);
+
+public:
+	FIniPack();
+	~FIniPack();
+
+	FIniPack(const FIniPack&) = delete;
+	FIniPack& operator=(const FIniPack&) = delete;
+
+	/**
+	 * Open a pack and read its table of contents
+	 *
+	 * @param IN PackPath
+	 * @param IN bMemoryMap Map the pack instead of reading documents through a file handle, if the platform supports it
+	 * @return True if the pack was opened
+	 */
+	bool Open(const FString& PackPath, bool bMemoryMap = true);
+
+	/** Release the mapping or file handle */
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return MappedRegion.IsValid() || FileHandle.IsValid(); }
+	FORCEINLINE bool IsMemoryMapped() const { return MappedRegion.IsValid(); }
+	FORCEINLINE int32 GetNumOfDocuments() const { return Entries.Num(); }
+
+	/**
+	 * @param IN RelativePath
+	 * @return True if the pack has a document at that path
+	 */
+	bool Contains(const FString& RelativePath) const;
+
+	/**
+	 * Parse one document. Safe to call from several threads.
+	 *
+	 * @param IN RelativePath
+	 * @param OUT OutData
+	 * @return True if the document exists and was read
+	 */
+	bool ReadDocument(const FString& RelativePath, FIniData& OutData) const;
+
+private:
+	struct FEntry
+	{
+		uint64 Hash = 0;
+		uint64 Offset = 0;
+		uint32 Length = 0;
+		uint32 Reserved = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+		{
+			return Ar << Entry.Hash << Entry.Offset << Entry.Length << Entry.Reserved;
+		}
+	};
+
+	/** Size of the header and of one table entry on disk */
+	static constexpr int64 HEADER_SIZE = 16;
+	static constexpr int64 ENTRY_SIZE = 24;
+
+	FString PackPath;
+
+	/** Sorted by hash */
+	TArray<FEntry> Entries;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	TUniquePtr<IFileHandle> FileHandle;
+	mutable FCriticalSection FileLock;
+
+private:
+	const FEntry* FindEntry(const FString& RelativePath) const;
+
+	// Data holds at least the header and the table, FileSize is the size of the whole pack.
+	bool ReadTableOfContents(const uint8* Data, int64 Size, int64 FileSize);
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Cumulative parser and I/O counters for one source (a file path, or "<string>" for in-memory calls) */
+struct INIPARSER_API FIniSourceStats
+{
+	int32 NumReads = 0;
+	int32 NumWrites = 0;
+
+	int64 BytesRead = 0;
+	int64 BytesWritten = 0;
+
+	int64 LinesRead = 0;
+	int64 LinesWritten = 0;
+
+	/** Comments, section headers and property lines read (see FIniDataBuilder::NumEntries) */
+	int64 EntriesRead = 0;
+
+	double ReadSeconds = 0.0;
+	double WriteSeconds = 0.0;
+};
+
+/**
+ * Process-wide registry behind the ini parser's Insights counters, CSV stats and the "IniParser.Stats.Dump" console command.
+ * Recording is controlled by "IniParser.Stats.Enable" and costs one lock and one map lookup per parsed or written document.
+ */
+class INIPARSER_API FIniParserStats
+{
+public:
+	/** Key used for ParseIniFromString/ParseIniToString calls that are not backed by a file */
+	static const TCHAR* STRING_SOURCE;
+
+	/**
+	 * @return True if recording is enabled
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Record one parsed document
+	 *
+	 * @param IN Source File path or STRING_SOURCE
+	 * @param IN Bytes Size of the source in bytes
+	 * @param IN Lines
+	 * @param IN Entries Comments, section headers and property lines
+	 * @param IN Seconds Wall time, including file I/O for files
+	 */
+	static void RecordRead(const FString& Source, int64 Bytes, int64 Lines, int64 Entries, double Seconds);
+
+	/**
+	 * Record one serialized document
+	 *
+	 * @param IN Source File path or STRING_SOURCE
+	 * @param IN Bytes Size of the output in bytes
+	 * @param IN Lines
+	 * @param IN Seconds Wall time, including file I/O for files
+	 */
+	static void RecordWrite(const FString& Source, int64 Bytes, int64 Lines, double Seconds);
+
+	/**
+	 * @return Copy of the stats recorded so far, keyed by source
+	 */
+	static TMap<FString, FIniSourceStats> GetSnapshot();
+
+	/** Forget everything recorded so far */
+	static void Reset();
+
+	/**
+	 * Print a table of per-source stats, slowest first
+	 *
+	 * @param IN Output
+	 */
+	static void Dump(FOutputDevice& Output);
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+#include "IniPatch.generated.h"
+
+/* Kind of change recorded by a patch entry */
+UENUM(BlueprintType)
+enum class EIniPatchOperation : uint8
+{
+	AddSection,
+	RemoveSection,
+	SetProperty,
+	RemoveProperty,
+	AddComment,
+	RemoveComment
+};
+
+/* A single change, either to the global scope or to one section. A section named [None] is not the global scope. */
+USTRUCT(BlueprintType)
+struct FIniPatchEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	EIniPatchOperation Operation = EIniPatchOperation::SetProperty;
+
+	/** True for global properties and comments; Section is unused then */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	bool bGlobal = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FName Section;
+
+	/** Property name, unused for section and comment operations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FName Key;
+
+	/** New property value, or the comment text */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FString Value;
+
+	/** New array elements, if the property is an array */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	TArray<FString> Values;
+
+public:
+	FIniPatchEntry()
+		: Section()
+		, Key()
+		, Value()
+		, Values()
+	{ }
+
+	FIniPatchEntry(EIniPatchOperation NewOperation, FName NewSection, FName NewKey, FString NewValue)
+		: Operation(NewOperation)
+		, Section(NewSection)
+		, Key(NewKey)
+		, Value(MoveTemp(NewValue))
+		, Values()
+	{ }
+
+	FIniPatchEntry(EIniPatchOperation NewOperation, FName NewSection, FName NewKey, const FIniProperty& NewProperty)
+		: Operation(NewOperation)
+		, Section(NewSection)
+		, Key(NewKey)
+		, Value(NewProperty.GetValue())
+		, Values(NewProperty.GetValues())
+	{ }
+
+	/** Change to the global scope */
+	FIniPatchEntry(EIniPatchOperation NewOperation, FName NewKey, FString NewValue)
+		: Operation(NewOperation)
+		, bGlobal(true)
+		, Section()
+		, Key(NewKey)
+		, Value(MoveTemp(NewValue))
+		, Values()
+	{ }
+
+	/** Change to the global scope */
+	FIniPatchEntry(EIniPatchOperation NewOperation, FName NewKey, const FIniProperty& NewProperty)
+		: Operation(NewOperation)
+		, bGlobal(true)
+		, Section()
+		, Key(NewKey)
+		, Value(NewProperty.GetValue())
+		, Values(NewProperty.GetValues())
+	{ }
+
+	/**
+	 * @return The property a SetProperty entry assigns
+	 */
+	FORCEINLINE FIniProperty MakeProperty() const { return Values.Num() > 0 ? FIniProperty(Values) : FIniProperty(Value); }
+};
+
+/* Structural difference between two .ini documents. Entries are grouped by section, so applying a patch touches every section once. */
+USTRUCT(BlueprintType)
+struct FIniPatch
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Details", meta = (AllowPrivateAccess = true))
+	TArray<FIniPatchEntry> Entries;
+
+public:
+	FORCEINLINE int32 GetNumOfEntries() const { return Entries.Num(); }
+	FORCEINLINE const TArray<FIniPatchEntry>& GetEntries() const { return Entries; }
+	FORCEINLINE bool IsEmpty() const { return Entries.IsEmpty(); }
+
+public:
+	/**
+	 * Compute the changes that turn one document into another, walking both documents once.
+	 * Documents with case-sensitive keys (see FIniData::HasKeyedProperties) are not supported and give an empty patch.
+	 *
+	 * @param IN From The original document.
+	 * @param IN To The changed document.
+	 * @return A patch that turns From into To when applied.
+	 */
+	static FIniPatch Compute(const FIniData& From, const FIniData& To);
+
+	/**
+	 * Apply the patch in place. Documents with case-sensitive keys are refused with a logged error.
+	 *
+	 * @param OUT Data
+	 * @return False if the document has case-sensitive keys and was left unchanged.
+	 */
+	bool Apply(FIniData& Data) const;
+
+	/**
+	 * Append a change
+	 *
+	 * @param IN Entry
+	 */
+	void AddEntry(FIniPatchEntry Entry);
+};
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/KismetStringLibrary.h"
+#include "IniValueParser.h"
 #include "IniProperty.generated.h"
 
 /* .ini property - Every property has a name and a value, delimited by an equals sign (=). The name appears to the left of the equals sign. In the Windows implementation the equal sign and the semicolon are reserved characters and cannot appear in the key. The value can contain any character. */
@@ -16,16 +17,63 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Details", meta = (AllowPrivateAccess = true))
 	FString Value;
 
+	/** Elements of an array property ("+Key=..." lines), stored contiguously. Value is empty while this is not. */
+	UPROPERTY(EditAnywhere, Category = "Details", meta = (AllowPrivateAccess = true))
+	TArray<FString> Values;
+
 public:
 	FIniProperty()
 		: Value()
+		, Values()
 	{ }
 
 	FIniProperty(FString NewValue)
-		: Value(NewValue)
+		: Value(MoveTemp(NewValue))
+		, Values()
 	{ }
 
+	FIniProperty(TArray<FString> NewValues)
+		: Value()
+		, Values(MoveTemp(NewValues))
+	{ }
+
+public:
+	FORCEINLINE bool operator==(const FIniProperty& Other) const
+	{
+		if (!Value.Equals(Other.Value, ESearchCase::CaseSensitive) || Values.Num() != Other.Values.Num())
+			return false;
+
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			if (!Values[Index].Equals(Other.Values[Index], ESearchCase::CaseSensitive))
+				return false;
+		}
+
+		return true;
+	}
+
+	FORCEINLINE bool operator!=(const FIniProperty& Other) const { return !(*this == Other); }
+
 public:
+	/**
+	 * Get the stored value, exactly as it was parsed or assigned. Empty for array properties, see GetValues.
+	 *
+	 * @return A reference to the value
+	 */
+	FORCEINLINE const FString& GetValue() const { return Value; }
+
+	/**
+	 * @return True if the property holds array elements instead of a single value
+	 */
+	FORCEINLINE bool IsArray() const { return Values.Num() > 0; }
+
+	/**
+	 * Get the array elements in file order
+	 *
+	 * @return A reference to the elements, empty if this is not an array
+	 */
+	FORCEINLINE const TArray<FString>& GetValues() const { return Values; }
+
 	/**
 	 * Get value as a raw String (without double quotes)
 	 *
@@ -42,14 +90,11 @@ public:
 	FORCEINLINE FString GetValueAsString() const { return Stringfy(Value); }
 
 	/**
-	 * Get value as a String with double quotes (if whitespace detected)
+	 * Get value as a String with double quotes (if whitespace or ';' detected and the value is not quoted yet)
 	 *
 	 * @return A string
 	 */
-	FORCEINLINE FString GetValueReadableString() const
-	{
-		return Value.MatchesWildcard(TEXT("* *")) ? Stringfy(Value) : Value;
-	}
+	FString GetValueReadableString() const;
 
 	/**
 	 * Get value as a Text
@@ -70,21 +115,36 @@ public:
 	 *
 	 * @param OUT OutValue
 	 */
-	FORCEINLINE void GetValueAsByte(uint8& OutValue) const { return LexFromString(OutValue, *Value); }
+	FORCEINLINE void GetValueAsByte(uint8& OutValue) const
+	{
+		int32 Parsed;
+		if (FIniValueParser::ParseInt32(Value, Parsed))
+			OutValue = static_cast<uint8>(Parsed);
+		else
+			LexFromString(OutValue, *Value);
+	}
 
 	/**
 	 * Get value as a int32
 	 *
 	 * @param OUT OutValue
 	 */
-	FORCEINLINE void GetValueAsInt(int32& OutValue) const { return LexFromString(OutValue, *Value); }
+	FORCEINLINE void GetValueAsInt(int32& OutValue) const
+	{
+		if (!FIniValueParser::ParseInt32(Value, OutValue))
+			LexFromString(OutValue, *Value);
+	}
 
 	/**
 	 * Get value as a int64
 	 *
 	 * @param OUT OutValue
 	 */
-	FORCEINLINE void GetValueAsInt64(int64& OutValue) const { return LexFromString(OutValue, *Value); }
+	FORCEINLINE void GetValueAsInt64(int64& OutValue) const
+	{
+		if (!FIniValueParser::ParseInt64(Value, OutValue))
+			LexFromString(OutValue, *Value);
+	}
 
 	/**
 	 * Get value as a boolean
@@ -98,14 +158,22 @@ public:
 	 *
 	 * @param OUT OutValue
 	 */
-	FORCEINLINE void GetValueAsFloat(float& OutValue) const { return LexFromString(OutValue, *Value); }
+	FORCEINLINE void GetValueAsFloat(float& OutValue) const
+	{
+		if (!FIniValueParser::ParseFloat(Value, OutValue))
+			LexFromString(OutValue, *Value);
+	}
 
 	/**
 	 * Get value as a double
 	 *
 	 * @param OUT OutValue
 	 */
-	FORCEINLINE void GetValueAsDouble(double& OutValue) const { return LexFromString(OutValue, *Value); }
+	FORCEINLINE void GetValueAsDouble(double& OutValue) const
+	{
+		if (!FIniValueParser::ParseDouble(Value, OutValue))
+			LexFromString(OutValue, *Value);
+	}
 
 	/**
 	 * Get value as a LinearColor
@@ -115,6 +183,12 @@ public:
 	 */
 	FORCEINLINE void GetValueAsColor(FLinearColor& OutConvertedColor, bool& OutIsValid) const
 	{
+		if (FIniValueParser::ParseColor(Value, OutConvertedColor))
+		{
+			OutIsValid = true;
+			return;
+		}
+
 		UKismetStringLibrary::Conv_StringToColor(Value, OutConvertedColor, OutIsValid);
 	}
 
@@ -126,6 +200,12 @@ public:
 	 */
 	FORCEINLINE void GetValueAsRotator(FRotator& OutConvertedRotator, bool& OutIsValid) const
 	{
+		if (FIniValueParser::ParseRotator(Value, OutConvertedRotator))
+		{
+			OutIsValid = true;
+			return;
+		}
+
 		UKismetStringLibrary::Conv_StringToRotator(Value, OutConvertedRotator, OutIsValid);
 	}
 
@@ -137,6 +217,12 @@ public:
 	 */
 	FORCEINLINE void GetValueAsVector(FVector& OutConvertedVector, bool& OutIsValid) const
 	{
+		if (FIniValueParser::ParseVector(Value, OutConvertedVector))
+		{
+			OutIsValid = true;
+			return;
+		}
+
 		UKismetStringLibrary::Conv_StringToVector(Value, OutConvertedVector, OutIsValid);
 	}
 
@@ -148,6 +234,12 @@ public:
 	 */
 	FORCEINLINE void GetValueAsVector2D(FVector2D& OutConvertedVector2D, bool& OutIsValid) const
 	{
+		if (FIniValueParser::ParseVector2D(Value, OutConvertedVector2D))
+		{
+			OutIsValid = true;
+			return;
+		}
+
 		UKismetStringLibrary::Conv_StringToVector2D(Value, OutConvertedVector2D, OutIsValid);
 	}
 
@@ -159,10 +251,38 @@ public:
 	 */
 	FORCEINLINE void GetValueAsVector3f(FVector3f& OutConvertedVector, bool& OutIsValid) const
 	{
+		if (FIniValueParser::ParseVector3f(Value, OutConvertedVector))
+		{
+			OutIsValid = true;
+			return;
+		}
+
 		UKismetStringLibrary::Conv_StringToVector3f(Value, OutConvertedVector, OutIsValid);
 	}
 
 public:
+	/**
+	 * Append an array element ("+Key=Value"). A plain value set before becomes the first element, as in Unreal config files.
+	 *
+	 * @param IN NewValue
+	 */
+	void AddValue(FString NewValue);
+
+	/**
+	 * Remove every array element equal to the value ("-Key=Value"), or clear a matching plain value
+	 *
+	 * @param IN OldValue
+	 * @return Number of elements removed
+	 */
+	int32 RemoveValue(const FString& OldValue);
+
+	/**
+	 * Replace the property with array elements
+	 *
+	 * @param IN NewValues
+	 */
+	void SetValues(TArray<FString> NewValues);
+
 	/**
 	 * Set value as a String type
 	 *
@@ -312,5 +432,5 @@ public:
 
 private:
 	// Create a new string, surrounded by double quotes.
-	FORCEINLINE FString Stringfy(const FString& NewValue) const { return TEXT("\"") + Value + TEXT("\""); }
+	FORCEINLINE FString Stringfy(const FString& NewValue) const { return TEXT("\"") + NewValue + TEXT("\""); }
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+
+/* One property matched by FIniQuery */
+struct INIPARSER_API FIniQueryResult
+{
+	/** NAME_None for global properties */
+	FName Section;
+	FName Property;
+
+	/** Points into the queried document */
+	const FIniProperty* Value = nullptr;
+};
+
+/* Secondary indexes FIniQuery can build. Queries still work without them, by scanning every property. */
+enum class EIniQueryIndex : uint8
+{
+	None = 0,
+
+	/** Value -> (section, key), for FindByValue */
+	Values = 1 << 0,
+
+	/** Prefix trie over key names, for FindByKeyPrefix and FindByKeyWildcard */
+	Keys = 1 << 1,
+
+	All = Values | Keys,
+};
+
+ENUM_CLASS_FLAGS(EIniQueryIndex);
+
+/**
+ * Read-only query engine over one document, e.g. "which sections have Class=Weapon" or "all keys matching Damage*".
+ * Results point into the document, which must outlive the query and must not be modified while it is in use.
+ * Key matching is case-insensitive, like FName. Value matching is case-insensitive, like FString keys in TMap; array properties match on any element.
+ */
+class INIPARSER_API FIniQuery
+{
+public:
+	/**
+	 * Index a document. Lazily loaded sections are parsed first.
+	 * Documents with case-sensitive keys (see FIniData::HasKeyedProperties) are not supported; nothing is indexed and every query finds nothing.
+	 *
+	 * @param IN Data
+	 * @param IN InIndexes Which secondary indexes to build
+	 */
+	explicit FIniQuery(const FIniData& Data, EIniQueryIndex InIndexes = EIniQueryIndex::All);
+
+	FORCEINLINE int32 GetNumOfEntries() const { return Entries.Num(); }
+
+	/**
+	 * Find properties with a value, in any key
+	 *
+	 * @param IN Value
+	 * @param OUT OutResults Matches are appended in document order
+	 */
+	void FindByValue(const FString& Value, TArray<FIniQueryResult>& OutResults) const;
+
+	/**
+	 * Find properties named Key with a value, e.g. every section with Class=Weapon
+	 *
+	 * @param IN Key
+	 * @param IN Value
+	 * @param OUT OutResults Matches are appended in document order
+	 */
+	void FindByValue(const FName& Key, const FString& Value, TArray<FIniQueryResult>& OutResults) const;
+
+	/**
+	 * Find properties whose key starts with a prefix
+	 *
+	 * @param IN Prefix
+	 * @param OUT OutResults Matches are appended grouped by key
+	 */
+	void FindByKeyPrefix(const FString& Prefix, TArray<FIniQueryResult>& OutResults) const;
+
+	/**
+	 * Find properties whose key matches a pattern with '*' and '?'. The literal text before the first wildcard narrows the search through the trie.
+	 *
+	 * @param IN Pattern
+	 * @param OUT OutResults Matches are appended grouped by key
+	 */
+	void FindByKeyWildcard(const FString& Pattern, TArray<FIniQueryResult>& OutResults) const;
+
+	/**
+	 * Visit every property of every section whose name matches a pattern with '*' and '?'
+	 *
+	 * @param IN SectionPattern
+	 * @param OUT OutResults Matches are appended in document order
+	 */
+	void FindBySection(const FString& SectionPattern, TArray<FIniQueryResult>& OutResults) const;
+
+private:
+	/* Trie node; children are a singly linked list, which keeps nodes small for large key sets */
+	struct FTrieNode
+	{
+		TCHAR Char = 0;
+		int32 FirstChild = INDEX_NONE;
+		int32 NextSibling = INDEX_NONE;
+
+		/** Index into Keys if a key ends here */
+		int32 Key = INDEX_NONE;
+	};
+
+	/* A distinct key name and every entry that uses it */
+	struct FKeyEntries
+	{
+		FName Name;
+		TArray<int32> Entries;
+	};
+
+	EIniQueryIndex Indexes;
+
+	/** Every property of the document, globals first, then sections in order */
+	TArray<FIniQueryResult> Entries;
+
+	TArray<FKeyEntries> Keys;
+	TMap<FName, int32> KeyLookup;
+
+	TMap<FString, TArray<int32>> ValueIndex;
+
+	/** Node 0 is the root; empty if the key index was not built */
+	TArray<FTrieNode> Trie;
+
+private:
+	void AddEntry(const FName& Section, const FName& Property, const FIniProperty& Value);
+
+	void InsertKey(int32 KeyIndex);
+
+	// Collect keys below a node that match Pattern (or every key if Pattern is null).
+	void CollectKeys(int32 Node, const FString* Pattern, TArray<FIniQueryResult>& OutResults) const;
+
+	// Walk the trie along a prefix; INDEX_NONE if no key starts with it.
+	int32 FindNode(const TCHAR* Prefix, int32 Len) const;
+
+	void AppendKey(int32 KeyIndex, TArray<FIniQueryResult>& OutResults) const;
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+
+#include <atomic>
+
+/* Read count of one key, as reported by FIniReadTelemetry */
+struct INIPARSER_API FIniKeyReadCount
+{
+	/** NAME_None for global properties, ANY_SECTION for reads made through FIniSection directly */
+	FName Section;
+	FName Property;
+	uint64 NumReads = 0;
+};
+
+/**
+ * Optional read counters for .ini keys, fed by the UIniLibrary getters, FIniData::FindProperty and FIniSection::FindProperty.
+ * Off by default ("IniParser.ReadTelemetry.Enable"); when off every hook is a single relaxed load.
+ * Counters are sharded by thread, so concurrent readers rarely touch the same lock.
+ */
+class INIPARSER_API FIniReadTelemetry
+{
+public:
+	/** Section reported for reads made through FIniSection, which does not know its own name */
+	static const FName ANY_SECTION;
+
+	/**
+	 * @return True if reads are being counted
+	 */
+	static FORCEINLINE bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * Start or stop counting reads. Counts recorded so far are kept.
+	 *
+	 * @param IN bNewEnabled
+	 */
+	static void SetEnabled(bool bNewEnabled);
+
+	/**
+	 * Count one read, if enabled
+	 *
+	 * @param IN Section NAME_None for global properties
+	 * @param IN Property
+	 */
+	static FORCEINLINE void RecordRead(const FName& Section, const FName& Property)
+	{
+		if (IsEnabled())
+			RecordReadSlow(Section, Property);
+	}
+
+	/**
+	 * @param IN MaxNum Number of keys to return, or all if negative
+	 * @return Keys that were read at least once, most read first
+	 */
+	static TArray<FIniKeyReadCount> GetHottestKeys(int32 MaxNum = -1);
+
+	/**
+	 * Find keys of a document that were never read. A key read through FIniSection (ANY_SECTION) counts as read in every section.
+	 *
+	 * @param IN Data
+	 * @return Keys with a read count of zero; Section is NAME_None for global properties
+	 */
+	static TArray<FIniKeyReadCount> GetUnreadKeys(const FIniData& Data);
+
+	/** Forget all counts */
+	static void Reset();
+
+	/**
+	 * Print the hottest keys
+	 *
+	 * @param IN MaxNum
+	 * @param IN Output
+	 */
+	static void Dump(int32 MaxNum, FOutputDevice& Output);
+
+private:
+	static std::atomic<bool> bEnabled;
+
+	static void RecordReadSlow(const FName& Section, const FName& Property);
+};
\ No newline at end of file
@@ -0,0 +1,124 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+#include "IniSchema.generated.h"
+
+/* One schema violation. Section is NAME_None for global properties, Key is NAME_None for section-level problems. */
+USTRUCT(BlueprintType)
+struct FIniSchemaViolation
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FName Section;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FName Key;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Details")
+	FString Message;
+
+	FIniSchemaViolation() = default;
+
+	FIniSchemaViolation(FName InSection, FName InKey, FString InMessage)
+		: Section(InSection)
+		, Key(InKey)
+		, Message(MoveTemp(InMessage))
+	{ }
+};
+
+/**
+ * Declarative validation for .ini data. The schema is itself an .ini document, one section per validated section
+ * (names may use '*' and '?'), global properties for global keys:
+ *
+ *   [Weapon.*]
+ *   .unknown = deny
+ *   Damage = float, required, min=0, max=500
+ *   Class = string, values=Sword|Bow|Staff
+ *   Ammo = int, min=0
+ *
+ * ".required = true" makes a section with an exact name mandatory, ".unknown = deny" reports keys that have no rule.
+ * Types: string, name, int, float, bool, vector, rotator, color. For string and name, min/max limit the length.
+ * Rules apply to every element of an array property.
+ * Compile once, then Validate checks each property with one hash lookup and reports every violation in one pass.
+ */
+class INIPARSER_API FIniSchema
+{
+public:
+	/**
+	 * Compile a schema
+	 *
+	 * @param IN SchemaData
+	 * @param OUT OutErrors Problems in the schema itself; rules with errors are skipped, and a schema with case-sensitive keys compiles to no rules
+	 * @return The compiled schema
+	 */
+	static FIniSchema Compile(const FIniData& SchemaData, TArray<FString>& OutErrors);
+
+	/**
+	 * Check a document against the schema. Documents with case-sensitive keys are not checked and give a single violation.
+	 *
+	 * @param IN Data
+	 * @param OUT OutViolations Appended in document order
+	 * @return True if there were no violations
+	 */
+	bool Validate(const FIniData& Data, TArray<FIniSchemaViolation>& OutViolations) const;
+
+private:
+	enum class EType : uint8
+	{
+		String,
+		Name,
+		Int,
+		Float,
+		Bool,
+		Vector,
+		Rotator,
+		Color
+	};
+
+	struct FRule
+	{
+		FName Key;
+		EType Type = EType::String;
+		bool bRequired = false;
+		bool bHasMin = false;
+		bool bHasMax = false;
+		double Min = 0.0;
+		double Max = 0.0;
+
+		/** Empty if any value is allowed; compared case-insensitively */
+		TArray<FString> AllowedValues;
+	};
+
+	/* Precompiled rules of one schema section */
+	struct FSectionValidator
+	{
+		FString Pattern;
+		bool bRequired = false;
+		bool bDenyUnknown = false;
+
+		TArray<FRule> Rules;
+		TMap<FName, int32> RuleIndex;
+	};
+
+	FSectionValidator GlobalValidator;
+
+	/** Sections with exact names, looked up by hash */
+	TMap<FName, FSectionValidator> SectionValidators;
+
+	/** Sections with wildcards, tried in schema order when there is no exact match */
+	TArray<FSectionValidator> PatternValidators;
+
+private:
+	static void CompileSection(const TMap<FName, FIniProperty>& Properties, FSectionValidator& OutValidator, TArray<FString>& OutErrors);
+
+	const FSectionValidator* FindValidator(const FName& SectionName) const;
+
+	static void ValidateProperties(const FSectionValidator& Validator, const FName& SectionName, const TMap<FName, FIniProperty>& Properties, TArray<FIniSchemaViolation>& OutViolations);
+
+	// Check one value; returns an empty string if it is valid.
+	static FString CheckValue(const FRule& Rule, const FString& Value);
+};
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "IniProperty.h"
+#include "IniKeyTable.h"
 #include "IniSection.generated.h"
 
 /* .ini section - The section name appears on a line by itself, in square brackets ([ and ]). All keys after the section declaration are associated with that section. There is no explicit "end of section" delimiter; sections end at the next section declaration, or at the end of the file. Sections cannot be nested. */
@@ -19,17 +20,57 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Details", meta = (AllowPrivateAccess = true))
 	TMap<FName, FIniProperty> Properties;
 
+	/** Properties of an EIniKeyMode::CaseSensitive document. Not reflected, so they are not visible to Blueprint details panels. */
+	FIniKeyTable KeyedProperties;
+
 public:
 	FORCEINLINE int32 GetNumOfComments() const { return Comments.Num(); }
-	FORCEINLINE int32 GetNumOfProperties() const { return Properties.Num(); }
-	FORCEINLINE TArray<FString> GetComments() const { return Comments; }
-	FORCEINLINE TMap<FName, FIniProperty> GetProperties() const { return Properties; }
+	FORCEINLINE int32 GetNumOfProperties() const { return Properties.Num() + KeyedProperties.Num(); }
+	FORCEINLINE const TArray<FString>& GetComments() const { return Comments; }
+	FORCEINLINE const TMap<FName, FIniProperty>& GetProperties() const { return Properties; }
+	FORCEINLINE const FIniKeyTable& GetKeyedProperties() const { return KeyedProperties; }
+	FORCEINLINE FIniKeyTable& GetKeyedProperties() { return KeyedProperties; }
 	FORCEINLINE bool HasComment(const FString& Comment) const { return Comments.Contains(Comment); }
 	FORCEINLINE bool HasProperty(const FName& PropertyName) const { return Properties.Contains(PropertyName); }
 	FORCEINLINE bool HasEmptyComments() const { return Comments.IsEmpty(); }
-	FORCEINLINE bool HasEmptyProperties() const { return Properties.IsEmpty(); }
+	FORCEINLINE bool HasEmptyProperties() const { return Properties.IsEmpty() && KeyedProperties.IsEmpty(); }
 
 public:
+	/**
+	 * Preallocate memory for properties and comments, so the containers do not grow while being filled.
+	 *
+	 * @param IN NumProperties
+	 * @param IN NumComments
+	 * @param IN KeyMode Which property container to size
+	 */
+	void Reserve(int32 NumProperties, int32 NumComments, EIniKeyMode KeyMode = EIniKeyMode::Name);
+
+	/**
+	 * Find a property by its key text: case-sensitively among the keyed properties first, then among the FName properties.
+	 * Never adds to the global name table.
+	 *
+	 * @param IN Key
+	 * @return A pointer to the property, or nullptr
+	 */
+	FIniProperty* FindPropertyByString(FStringView Key);
+
+	/**
+	 * Find a case-sensitive keyed property, or add one with the given value
+	 *
+	 * @param IN Key
+	 * @param IN Value Used only if the key is new
+	 * @return A reference to the property. The reference is only valid until the next change to the keyed properties.
+	 */
+	FIniProperty& FindOrAddKeyedProperty(FStringView Key, FString&& Value);
+
+	/**
+	 * Remove a case-sensitive keyed property
+	 *
+	 * @param IN Key
+	 * @return True if a property was removed.
+	 */
+	bool RemoveKeyedProperty(FStringView Key);
+
 	/**
 	 * Find .ini property associated with a specified name.
 	 *
@@ -56,6 +97,16 @@ public:
 	 */
 	FIniProperty& FindOrAddProperty(const FName& Key, const FString& Value);
 
+	/**
+	 * Find the value associated with a specified name, or if none exists,
+	 * adds a .ini property by moving the value in.
+	 *
+	 * @param IN Key The name to search for.
+	 * @param IN Value The value to associate the property with.
+	 * @return A reference to the value associated with the specified name.
+	 */
+	FIniProperty& FindOrAddProperty(const FName& Key, FString&& Value);
+
 	/**
 	 * Add a new .ini property
 	 *
@@ -65,6 +116,24 @@ public:
 	 */
 	FIniProperty& AddProperty(const FName& Key, const FString& Value);
 
+	/**
+	 * Add a new .ini property by moving the value in
+	 *
+	 * @param IN Key The key to associate the property with.
+	 * @param IN Value The value to associate the property with.
+	 * @return A property of .ini property. The reference is only valid until the next change to any key in the map.
+	 */
+	FIniProperty& AddProperty(const FName& Key, FString&& Value);
+
+	/**
+	 * Add an existing .ini property by moving it into the section
+	 *
+	 * @param IN Key The key to associate the property with.
+	 * @param IN Property The property to move in.
+	 * @return A property of .ini property. The reference is only valid until the next change to any key in the map.
+	 */
+	FIniProperty& AddProperty(const FName& Key, FIniProperty&& Property);
+
 	/**
 	 * Get a .ini property based on the name.
 	 *
@@ -73,6 +142,14 @@ public:
 	 */
 	FIniProperty& GetProperty(const FName& PropertyName);
 
+	/**
+	 * Remove a .ini property
+	 *
+	 * @param IN PropertyName The name to search for.
+	 * @return True if a property was removed.
+	 */
+	bool RemoveProperty(const FName& PropertyName);
+
 	/**
 	 * Add comment
 	 *
@@ -87,6 +164,28 @@ public:
 	 */
 	void AddUniqueComment(FString Comment);
 
+	/**
+	 * Remove the first matching comment
+	 *
+	 * @param IN Comment
+	 * @return True if a comment was removed.
+	 */
+	bool RemoveComment(const FString& Comment);
+
+	/**
+	 * Move all properties out of the section, leaving it without properties.
+	 *
+	 * @return The properties that were stored in the section.
+	 */
+	TMap<FName, FIniProperty> ExtractProperties();
+
+	/**
+	 * Move all comments out of the section, leaving it without comments.
+	 *
+	 * @return The comments that were stored in the section.
+	 */
+	TArray<FString> ExtractComments();
+
 public:
 	FIniSection()
 		: Comments()
@@ -95,16 +194,16 @@ public:
 
 	FIniSection(TMap<FName, FIniProperty> NewProperties)
 		: Comments()
-		, Properties(NewProperties)
+		, Properties(MoveTemp(NewProperties))
 	{ }
 
 	FIniSection(TMap<FName, FIniProperty> NewProperties, TArray<FString> NewComments)
-		: Comments(NewComments)
-		, Properties(NewProperties)
+		: Comments(MoveTemp(NewComments))
+		, Properties(MoveTemp(NewProperties))
 	{ }
 
 	FIniSection(TArray<FString> NewComments)
-		: Comments(NewComments)
+		: Comments(MoveTemp(NewComments))
 		, Properties()
 	{ }
 
@@ -0,0 +1,160 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "IniData.h"
+
+/* Copy-on-write handle to an .ini document. Copies are O(1) and share one immutable, ref-counted document; a holder only clones the document's section table, and then the individual section or the global scope, the first time it mutates them. */
+class INIPARSER_API FIniSharedData
+{
+public:
+	FIniSharedData();
+
+	/**
+	 * Take ownership of parsed .ini data. Sections are moved, not copied.
+	 *
+	 * @param IN Data
+	 */
+	explicit FIniSharedData(FIniData&& Data);
+
+	/**
+	 * Copy .ini data into a new shared document.
+	 *
+	 * @param IN Data
+	 */
+	explicit FIniSharedData(const FIniData& Data);
+
+public:
+	FORCEINLINE int32 GetNumOfSections() const { return Document->Sections.Num(); }
+	FORCEINLINE int32 GetNumOfProperties() const { return Document->Globals->Properties.Num() + Document->Globals->KeyedProperties.Num(); }
+	FORCEINLINE int32 GetNumOfComments() const { return Document->Globals->Comments.Num(); }
+	FORCEINLINE bool HasSection(const FName& SectionName) const { return Document->Sections.Contains(SectionName); }
+	FORCEINLINE const TMap<FName, FIniProperty>& GetProperties() const { return Document->Globals->Properties; }
+	FORCEINLINE const FIniKeyTable& GetKeyedProperties() const { return Document->Globals->KeyedProperties; }
+	FORCEINLINE const TArray<FString>& GetComments() const { return Document->Globals->Comments; }
+	FORCEINLINE EIniKeyMode GetKeyMode() const { return Document->Globals->KeyMode; }
+
+	/** True if no other handle shares this document. */
+	FORCEINLINE bool IsUnique() const { return Document.IsUnique(); }
+
+public:
+	/**
+	 * Find .ini section for reading.
+	 *
+	 * @param IN Key The name to search for.
+	 * @return A pointer to the section, or nullptr if the name isn't contained in this document.
+	 */
+	const FIniSection* FindSection(const FName& Key) const;
+
+	/**
+	 * Find a global property for reading.
+	 *
+	 * @param IN Key The name to search for.
+	 * @return A pointer to the property, or nullptr if the name isn't contained in this document.
+	 */
+	const FIniProperty* FindProperty(const FName& Key) const;
+
+	/**
+	 * Find a global property for reading by its key text: case-sensitively among the keyed properties first, then among the FName properties.
+	 *
+	 * @param IN Key
+	 * @return A pointer to the property, or nullptr if the key isn't contained in this document.
+	 */
+	const FIniProperty* FindPropertyByString(FStringView Key) const;
+
+	/**
+	 * Call a function for every section, in map order.
+	 *
+	 * @param IN Func Invoked as Func(const FName& SectionName, const FIniSection& Section)
+	 */
+	template <typename FuncType>
+	void ForEachSection(FuncType&& Func) const
+	{
+		for (const auto& SectionPair : Document->Sections)
+			Func(SectionPair.Key, SectionPair.Value.Get());
+	}
+
+public:
+	/**
+	 * Find a section for writing. Clones the section first if another handle still shares it.
+	 *
+	 * @param IN Key The name to search for.
+	 * @return A pointer to the section, or nullptr if the name isn't contained in this document.
+	 */
+	FIniSection* FindSectionForEdit(const FName& Key);
+
+	/**
+	 * Find or add a section for writing. Clones the section first if another handle still shares it.
+	 *
+	 * @param IN Key The name to search for.
+	 * @return A reference to the section, only valid until the next change to this handle.
+	 */
+	FIniSection& FindOrAddSectionForEdit(const FName& Key);
+
+	/**
+	 * Remove a section from this handle's view of the document.
+	 *
+	 * @param IN Key
+	 * @return True if a section was removed.
+	 */
+	bool RemoveSection(const FName& Key);
+
+	/**
+	 * Global properties for writing.
+	 *
+	 * @return A reference only valid until the next change to this handle.
+	 */
+	TMap<FName, FIniProperty>& EditProperties();
+
+	/**
+	 * Case-sensitive keyed global properties for writing.
+	 *
+	 * @return A reference only valid until the next change to this handle.
+	 */
+	FIniKeyTable& EditKeyedProperties();
+
+	/**
+	 * Global comments for writing.
+	 *
+	 * @return A reference only valid until the next change to this handle.
+	 */
+	TArray<FString>& EditComments();
+
+	/**
+	 * Materialize a standalone copy, e.g. to hand to Blueprint or UIniLibrary::ParseIniToString.
+	 *
+	 * @return A deep copy of the document.
+	 */
+	FIniData ToIniData() const;
+
+private:
+	typedef TSharedRef<FIniSection, ESPMode::ThreadSafe> FSectionRef;
+
+	/* Global scope, shared like a section so editing a section does not copy it */
+	struct FGlobals
+	{
+		TMap<FName, FIniProperty> Properties;
+		FIniKeyTable KeyedProperties;
+		TArray<FString> Comments;
+		EIniKeyMode KeyMode = EIniKeyMode::Name;
+	};
+
+	struct FDocument
+	{
+		TMap<FName, FSectionRef> Sections;
+		TSharedRef<FGlobals, ESPMode::ThreadSafe> Globals = MakeShared<FGlobals, ESPMode::ThreadSafe>();
+	};
+
+	TSharedRef<FDocument, ESPMode::ThreadSafe> Document;
+
+	// Detach from other handles. The copy shares every section and the global scope until each one is edited.
+	FDocument& MutableDocument();
+
+	// Detach a single section from other handles.
+	static FIniSection& MutableSection(FSectionRef& Section);
+
+	// Detach the global scope from other handles.
+	FGlobals& MutableGlobals();
+};
\ No newline at end of file
@@ -0,0 +1,109 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IniData.h"
+#include "IniPatch.h"
+
+class FIniConcurrentStore;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnIniTransactionCommitted, const FIniData& /* Data */, const FIniPatch& /* Changes */);
+
+/* Batch of staged edits. Nothing is visible until Commit, which sorts the edits by section so every section is looked up once, applies them in one go and sends a single notification with all changes. */
+class INIPARSER_API FIniTransaction
+{
+public:
+	/**
+	 * Stage a property value. Use NAME_None as section for global properties; a section named [None] can not be targeted.
+	 *
+	 * @param IN SectionName
+	 * @param IN PropertyName
+	 * @param IN Value
+	 */
+	void SetProperty(const FName& SectionName, const FName& PropertyName, FString Value);
+
+	/**
+	 * Stage a property value, e.g. one formatted by the FIniProperty setters.
+	 *
+	 * @param IN SectionName
+	 * @param IN PropertyName
+	 * @param IN Property
+	 */
+	void SetProperty(const FName& SectionName, const FName& PropertyName, const FIniProperty& Property);
+
+	/**
+	 * Stage removal of a property.
+	 *
+	 * @param IN SectionName
+	 * @param IN PropertyName
+	 */
+	void RemoveProperty(const FName& SectionName, const FName& PropertyName);
+
+	/**
+	 * Stage an empty section.
+	 *
+	 * @param IN SectionName
+	 */
+	void AddSection(const FName& SectionName);
+
+	/**
+	 * Stage removal of a section.
+	 *
+	 * @param IN SectionName
+	 */
+	void RemoveSection(const FName& SectionName);
+
+	/**
+	 * Stage a comment. Use NAME_None as section for global comments; a section named [None] can not be targeted.
+	 *
+	 * @param IN SectionName
+	 * @param IN Comment
+	 */
+	void AddComment(const FName& SectionName, FString Comment);
+
+	/**
+	 * Stage removal of a comment.
+	 *
+	 * @param IN SectionName
+	 * @param IN Comment
+	 */
+	void RemoveComment(const FName& SectionName, FString Comment);
+
+	FORCEINLINE int32 GetNumOfEdits() const { return Edits.Num(); }
+	FORCEINLINE bool IsEmpty() const { return Edits.IsEmpty(); }
+
+	/** Drop all staged edits. */
+	void Reset();
+
+	/**
+	 * Apply all staged edits to a document and broadcast OnCommitted once. The transaction is empty afterwards.
+	 * Documents with case-sensitive keys are refused (see FIniPatch::Apply); the edits are dropped and nothing is broadcast.
+	 *
+	 * @param OUT Data
+	 * @return The changes that were applied, empty if the document was refused.
+	 */
+	FIniPatch Commit(FIniData& Data);
+
+	/**
+	 * Apply all staged edits to a copy of the store's current version and publish it as one new version.
+	 * Versions with case-sensitive keys are refused like in Commit(FIniData&).
+	 * May be called from any thread; OnCommitted is broadcast on the game thread with the version this commit published.
+	 *
+	 * @param OUT Store
+	 * @return The changes that were applied, empty if the version was refused.
+	 */
+	FIniPatch Commit(FIniConcurrentStore& Store);
+
+	/**
+	 * Fired once per commit, after the edits were applied. Commit(FIniData&) broadcasts on the calling thread;
+	 * Commit(FIniConcurrentStore&) always broadcasts on the game thread, queued if it was called from another thread.
+	 */
+	static FOnIniTransactionCommitted& OnCommitted();
+
+private:
+	TArray<FIniPatchEntry> Edits;
+
+	// Sort by section (keeping the staging order inside a section) and move the edits into a patch.
+	FIniPatch BuildPatch();
+};
\ No newline at end of file
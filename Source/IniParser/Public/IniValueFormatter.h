@@ -0,0 +1,66 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Shortest round-trip formatting for .ini property values (IniParserCore::FormatDouble, std::to_chars where available). Output is the fewest significant digits that read back bit-exact through FIniValueParser (and FCString::Atod), written straight into the destination string. */
+struct INIPARSER_API FIniValueFormatter
+{
+	/** Large enough for any formatted double, including sign, exponent and the ".0" suffix */
+	static constexpr int32 MAX_NUMBER_LENGTH = 32;
+
+	/**
+	 * Format a double into a buffer
+	 *
+	 * @param IN Value
+	 * @param OUT Buffer At least MAX_NUMBER_LENGTH characters
+	 * @return Number of characters written (not counting the null terminator)
+	 */
+	static int32 FormatDouble(double Value, TCHAR* Buffer);
+
+	/**
+	 * Format a float into a buffer
+	 *
+	 * @param IN Value
+	 * @param OUT Buffer At least MAX_NUMBER_LENGTH characters
+	 * @return Number of characters written (not counting the null terminator)
+	 */
+	static int32 FormatFloat(float Value, TCHAR* Buffer);
+
+	/**
+	 * Append a double to a string
+	 *
+	 * @param OUT Out
+	 * @param IN Value
+	 */
+	static void AppendDouble(FString& Out, double Value);
+
+	/**
+	 * Append a float to a string
+	 *
+	 * @param OUT Out
+	 * @param IN Value
+	 */
+	static void AppendFloat(FString& Out, float Value);
+
+	/**
+	 * Append a "Key=Value" list separated by spaces, e.g. "X=1.0 Y=2.5 Z=0.0"
+	 *
+	 * @param OUT Out
+	 * @param IN Keys One character per component
+	 * @param IN Values
+	 * @param IN NumValues
+	 */
+	static void AppendComponents(FString& Out, const TCHAR* Keys, const double* Values, int32 NumValues);
+
+	/**
+	 * Append a "Key=Value" list separated by spaces, e.g. "X=1.0 Y=2.5 Z=0.0"
+	 *
+	 * @param OUT Out
+	 * @param IN Keys One character per component
+	 * @param IN Values
+	 * @param IN NumValues
+	 */
+	static void AppendComponents(FString& Out, const TCHAR* Keys, const float* Values, int32 NumValues);
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Allocation-free parsers for .ini property values, built on IniParserCore/IniValues.h. Every function only succeeds when the whole value (ignoring surrounding whitespace) is a well-formed literal, so callers can fall back to the engine converters for anything else. */
+struct INIPARSER_API FIniValueParser
+{
+	/**
+	 * Parse a signed 32-bit integer
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the whole string is a valid integer that fits into int32
+	 */
+	static bool ParseInt32(const FString& String, int32& OutValue);
+
+	/**
+	 * Parse a signed 64-bit integer
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the whole string is a valid integer that fits into int64
+	 */
+	static bool ParseInt64(const FString& String, int64& OutValue);
+
+	/**
+	 * Parse a double
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the whole string is a valid decimal number
+	 */
+	static bool ParseDouble(const FString& String, double& OutValue);
+
+	/**
+	 * Parse a float (parsed as double and narrowed, same as FCString::Atof)
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the whole string is a valid decimal number
+	 */
+	static bool ParseFloat(const FString& String, float& OutValue);
+
+	/**
+	 * Parse a "X=.. Y=.. Z=.." literal in one pass
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the literal was fully parsed
+	 */
+	static bool ParseVector(const FString& String, FVector& OutValue);
+
+	/**
+	 * Parse a "X=.. Y=.. Z=.." literal in one pass
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the literal was fully parsed
+	 */
+	static bool ParseVector3f(const FString& String, FVector3f& OutValue);
+
+	/**
+	 * Parse a "X=.. Y=.." literal in one pass
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the literal was fully parsed
+	 */
+	static bool ParseVector2D(const FString& String, FVector2D& OutValue);
+
+	/**
+	 * Parse a "P=.. Y=.. R=.." literal in one pass
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the literal was fully parsed
+	 */
+	static bool ParseRotator(const FString& String, FRotator& OutValue);
+
+	/**
+	 * Parse a "(R=..,G=..,B=..,A=..)" literal in one pass. Alpha is optional and defaults to 1.
+	 *
+	 * @param IN String
+	 * @param OUT OutValue
+	 * @return True if the literal was fully parsed
+	 */
+	static bool ParseColor(const FString& String, FLinearColor& OutValue);
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+using System.IO;
+using UnrealBuildTool;
+
+public class IniParserCore : ModuleRules
+{
+	public IniParserCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		// Header-only, engine-independent tokenizer and writers. Also builds standalone via CMakeLists.txt.
+		Type = ModuleType.External;
+
+		PublicSystemIncludePaths.Add(Path.Combine(ModuleDirectory, "include"));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/* Minimal test runner for the standalone core, so the tests build with nothing but a C++17 compiler */
+namespace IniParserCoreTests
+{
+	struct FTest
+	{
+		const char* Name;
+		std::function<void()> Body;
+	};
+
+	inline std::vector<FTest>& GetTests()
+	{
+		static std::vector<FTest> Tests;
+		return Tests;
+	}
+
+	inline int& GetNumFailures()
+	{
+		static int NumFailures = 0;
+		return NumFailures;
+	}
+
+	struct FRegistrar
+	{
+		FRegistrar(const char* Name, std::function<void()> Body)
+		{
+			GetTests().push_back({ Name, std::move(Body) });
+		}
+	};
+
+	inline void PrintDetail(const char* Format = nullptr, ...)
+	{
+		if (!Format)
+			return;
+
+		va_list Args;
+		va_start(Args, Format);
+		std::vprintf(Format, Args);
+		va_end(Args);
+	}
+
+	/** Runs every registered test. Returns 1 if any check failed, so CTest sees the failure. */
+	inline int RunAll()
+	{
+		for (const FTest& Test : GetTests())
+		{
+			const int Before = GetNumFailures();
+			Test.Body();
+			std::printf("%s %s\n", GetNumFailures() == Before ? "[ OK ]" : "[FAIL]", Test.Name);
+		}
+
+		std::printf("%zu tests, %d failed checks\n", GetTests().size(), GetNumFailures());
+		return GetNumFailures() > 0 ? 1 : 0;
+	}
+}
+
+#define INI_TEST_CONCAT_INNER(A, B) A##B
+#define INI_TEST_CONCAT(A, B) INI_TEST_CONCAT_INNER(A, B)
+
+/** Reports a failed condition with its location and an optional printf-style detail, and keeps going */
+#define INI_CHECK(Condition, ...) \
+	do \
+	{ \
+		if (!(Condition)) \
+		{ \
+			if (++IniParserCoreTests::GetNumFailures() <= 50) \
+			{ \
+				std::printf("%s:%d: check failed: %s ", __FILE__, __LINE__, #Condition); \
+				IniParserCoreTests::PrintDetail(__VA_ARGS__); \
+				std::printf("\n"); \
+			} \
+		} \
+	} while (false)
+
+/** Defines and registers a test: INI_TEST(Name) { ...checks... } */
+#define INI_TEST(Name) \
+	static void Name(); \
+	static IniParserCoreTests::FRegistrar INI_TEST_CONCAT(Name, _Registrar)(#Name, &Name); \
+	static void Name()
@@ -0,0 +1,8 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniTest.h"
+
+int main()
+{
+	return IniParserCoreTests::RunAll();
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniTest.h"
+
+#include "IniParserCore/IniDocument.h"
+#include "IniParserCore/IniTokenizer.h"
+#include "IniParserCore/IniWriter.h"
+
+#include <string>
+#include <vector>
+
+/* Checks where multi-line quoted values end, and that values which can not be written are left out instead of corrupting the file */
+namespace IniTokenizerTests
+{
+	/* Collects reported errors and ignores everything else */
+	struct FErrorHandler
+	{
+		std::vector<IniParserCore::ELineError> Errors;
+
+		void OnComment(IniParserCore::TSpan<char>) { }
+		void OnSection(IniParserCore::TSpan<char>) { }
+		void OnProperty(IniParserCore::TSpan<char>, IniParserCore::TSpan<char>) { }
+		void OnError(IniParserCore::ELineError Error, const char*) { Errors.push_back(Error); }
+	};
+
+	static std::vector<IniParserCore::ELineError> Tokenize(const std::string& Text)
+	{
+		FErrorHandler Handler;
+		IniParserCore::Tokenize(Text.data(), Text.data() + Text.size(), Handler);
+		return Handler.Errors;
+	}
+
+	static std::string GetValue(const IniParserCore::FDocument& Document, const char* Section, const char* Key)
+	{
+		const IniParserCore::FSection* Found = *Section ? Document.FindSection(Section) : &Document.Global;
+		const IniParserCore::FProperty* Property = Found ? Found->FindProperty(Key) : nullptr;
+
+		return Property ? Property->Value : std::string("<missing>");
+	}
+
+	static bool IsWritable(const std::string& Value)
+	{
+		return IniParserCore::IsWritable(IniParserCore::TSpan<char>{ Value.data(), Value.data() + Value.size() });
+	}
+}
+
+INI_TEST(MultiLineQuoteCloses)
+{
+	using namespace IniTokenizerTests;
+
+	const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse("[S]\nA=\"one\n  two = 2\n; three\nfour\"\nB=1\n");
+
+	INI_CHECK(GetValue(Document, "S", "A") == "one\n  two = 2\n; three\nfour", "%s", GetValue(Document, "S", "A").c_str());
+	INI_CHECK(GetValue(Document, "S", "B") == "1");
+	INI_CHECK(Tokenize("A=\"one\nfour\"\n").empty());
+}
+
+INI_TEST(UnterminatedQuoteStopsAtSection)
+{
+	using namespace IniTokenizerTests;
+
+	const std::string Text = "A=\"open\nB=1\n[Next]\nC=2\"\n";
+	const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse(Text);
+
+	// The value is kept as written and every following line still counts.
+	INI_CHECK(GetValue(Document, "", "A") == "\"open", "%s", GetValue(Document, "", "A").c_str());
+	INI_CHECK(GetValue(Document, "", "B") == "1");
+	INI_CHECK(GetValue(Document, "Next", "C") == "2\"");
+
+	const std::vector<IniParserCore::ELineError> Errors = Tokenize(Text);
+	INI_CHECK(Errors.size() == 1 && Errors[0] == IniParserCore::ELineError::UnterminatedQuote);
+}
+
+INI_TEST(UnterminatedQuoteStopsAtOpeningLine)
+{
+	using namespace IniTokenizerTests;
+
+	const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse("A=\"one\nB=\"two\nthree\"\n");
+
+	INI_CHECK(GetValue(Document, "", "A") == "\"one", "%s", GetValue(Document, "", "A").c_str());
+	INI_CHECK(GetValue(Document, "", "B") == "two\nthree", "%s", GetValue(Document, "", "B").c_str());
+}
+
+INI_TEST(UnterminatedQuoteAtEndOfText)
+{
+	using namespace IniTokenizerTests;
+
+	const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse("A=\"open\nB=1\nC=2");
+
+	INI_CHECK(GetValue(Document, "", "A") == "\"open");
+	INI_CHECK(GetValue(Document, "", "C") == "2");
+}
+
+INI_TEST(ClosedQuoteDoesNotOpen)
+{
+	using namespace IniTokenizerTests;
+
+	// Text after the closing quote keeps the value on its line.
+	const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse("A=\"x\" y\nB=1\"\n");
+
+	INI_CHECK(GetValue(Document, "", "A") == "\"x\" y", "%s", GetValue(Document, "", "A").c_str());
+	INI_CHECK(GetValue(Document, "", "B") == "1\"");
+	INI_CHECK(Tokenize("A=\"x\" y\n").empty());
+}
+
+INI_TEST(UnwritableValuesAreLeftOut)
+{
+	using namespace IniTokenizerTests;
+
+	INI_CHECK(IsWritable("single \"line\""));
+	INI_CHECK(IsWritable("one\ntwo [three]\nfour"), "only the first character of a line counts");
+	INI_CHECK(IsWritable("one\n  two\nthree\""));
+	INI_CHECK(!IsWritable("one \"quoted\"\ntwo"), "first line with a quote does not open");
+	INI_CHECK(!IsWritable("one\ntwo\"\nthree"), "inner line ending with a quote closes early");
+	INI_CHECK(!IsWritable("one\n[Section]\nthree"), "inner section header ends the value");
+	INI_CHECK(!IsWritable("one\nKey=\"two\nthree"), "inner opening line ends the value");
+
+	IniParserCore::FDocument Document;
+	IniParserCore::FSection& Section = Document.FindOrAddSection("S");
+	Section.FindOrAddProperty("Bad", "one\ntwo\"\nthree");
+	Section.FindOrAddProperty("Good", "one\ntwo");
+
+	const std::string Text = Document.Serialize();
+
+	INI_CHECK(Text == "[S]\nGood = \"one\ntwo\"", "%s", Text.c_str());
+	INI_CHECK(IniParserCore::FDocument::Parse(Text).Serialize() == Text);
+}
\ No newline at end of file
@@ -0,0 +1,315 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniTest.h"
+
+#include "IniParserCore/IniValues.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+/* Checks the value parsers against the CRT converters (strtoll/strtod) that LexFromString and FCString::Atod wrap in the engine */
+namespace IniValueTests
+{
+	static std::u16string Widen(const std::string& Text)
+	{
+		return std::u16string(Text.begin(), Text.end());
+	}
+
+	static bool ParseInteger(const std::string& Text, int64_t Min, int64_t Max, int64_t& OutValue)
+	{
+		int64_t Wide = 0;
+		const std::u16string WideText = Widen(Text);
+
+		const bool bNarrow = IniParserCore::ParseIntegerValue(Text.data(), Text.data() + Text.size(), Min, Max, OutValue);
+		const bool bWide = IniParserCore::ParseIntegerValue(WideText.data(), WideText.data() + WideText.size(), Min, Max, Wide);
+
+		// Both character widths must agree, including on failure.
+		INI_CHECK(bNarrow == bWide && (!bNarrow || Wide == OutValue), "'%s'", Text.c_str());
+		return bNarrow;
+	}
+
+	static bool ParseNumber(const std::string& Text, double& OutValue)
+	{
+		double Wide = 0.0;
+		const std::u16string WideText = Widen(Text);
+
+		const bool bNarrow = IniParserCore::ParseNumberValue(Text.data(), Text.data() + Text.size(), OutValue);
+		const bool bWide = IniParserCore::ParseNumberValue(WideText.data(), WideText.data() + WideText.size(), Wide);
+
+		INI_CHECK(bNarrow == bWide && (!bNarrow || std::memcmp(&Wide, &OutValue, sizeof(double)) == 0), "'%s'", Text.c_str());
+		return bNarrow;
+	}
+
+	static bool SameBits(double A, double B)
+	{
+		return std::memcmp(&A, &B, sizeof(double)) == 0;
+	}
+
+	/** strtod over the whole string, as the reference */
+	static bool ReferenceNumber(const std::string& Text, double& OutValue)
+	{
+		char* End = nullptr;
+		OutValue = std::strtod(Text.c_str(), &End);
+		return End == Text.c_str() + Text.size();
+	}
+
+	/** Random text in the grammar ParseNumberToken accepts: sign, digits, fraction and exponent, with long mantissas */
+	static std::string MakeDecimal(std::mt19937_64& Random)
+	{
+		std::string Text;
+
+		if (Random() % 3 == 0)
+			Text.push_back(Random() % 2 ? '-' : '+');
+
+		const int NumIntegerDigits = static_cast<int>(Random() % 24);
+		const int NumFractionDigits = NumIntegerDigits == 0 ? 1 + static_cast<int>(Random() % 24) : static_cast<int>(Random() % 24);
+
+		for (int Index = 0; Index < NumIntegerDigits; ++Index)
+			Text.push_back(static_cast<char>('0' + Random() % 10));
+
+		if (NumFractionDigits > 0 || Random() % 4 == 0)
+			Text.push_back('.');
+
+		for (int Index = 0; Index < NumFractionDigits; ++Index)
+			Text.push_back(static_cast<char>('0' + Random() % 10));
+
+		if (Random() % 2)
+		{
+			Text.push_back(Random() % 2 ? 'e' : 'E');
+
+			if (Random() % 2)
+				Text.push_back(Random() % 2 ? '-' : '+');
+
+			Text += std::to_string(Random() % 340);
+		}
+
+		return Text;
+	}
+
+	static double RandomFiniteDouble(std::mt19937_64& Random)
+	{
+		for (;;)
+		{
+			const uint64_t Bits = Random();
+			double Value;
+			std::memcpy(&Value, &Bits, sizeof(Value));
+
+			if (Value == Value && Value - Value == 0.0)
+				return Value;
+		}
+	}
+}
+
+using namespace IniValueTests;
+
+INI_TEST(IntegerLimits)
+{
+	const int64_t Min32 = std::numeric_limits<int32_t>::min();
+	const int64_t Max32 = std::numeric_limits<int32_t>::max();
+	const int64_t Min64 = std::numeric_limits<int64_t>::min();
+	const int64_t Max64 = std::numeric_limits<int64_t>::max();
+
+	int64_t Value = 0;
+
+	INI_CHECK(ParseInteger("2147483647", Min32, Max32, Value) && Value == Max32);
+	INI_CHECK(ParseInteger("-2147483648", Min32, Max32, Value) && Value == Min32);
+	INI_CHECK(!ParseInteger("2147483648", Min32, Max32, Value));
+	INI_CHECK(!ParseInteger("-2147483649", Min32, Max32, Value));
+
+	INI_CHECK(ParseInteger("9223372036854775807", Min64, Max64, Value) && Value == Max64);
+	INI_CHECK(ParseInteger("-9223372036854775808", Min64, Max64, Value) && Value == Min64);
+	INI_CHECK(!ParseInteger("9223372036854775808", Min64, Max64, Value));
+	INI_CHECK(!ParseInteger("-9223372036854775809", Min64, Max64, Value));
+	INI_CHECK(!ParseInteger("99999999999999999999999", Min64, Max64, Value));
+
+	INI_CHECK(ParseInteger("  +42\t", Min64, Max64, Value) && Value == 42);
+	INI_CHECK(ParseInteger("0000000000000000000000042", Min64, Max64, Value) && Value == 42);
+	INI_CHECK(ParseInteger("-0", Min64, Max64, Value) && Value == 0);
+
+	for (const char* Invalid : { "", " ", "+", "-", "1 2", "12a", "a12", "1.0", "1e3", "--1", "0x10", "１２" })
+		INI_CHECK(!ParseInteger(Invalid, Min64, Max64, Value), "'%s'", Invalid);
+}
+
+INI_TEST(IntegersMatchStrtoll)
+{
+	std::mt19937_64 Random(26);
+
+	const int64_t Min64 = std::numeric_limits<int64_t>::min();
+	const int64_t Max64 = std::numeric_limits<int64_t>::max();
+
+	for (int Iteration = 0; Iteration < 200000; ++Iteration)
+	{
+		// Random digit strings of every length, so the 8- and 4-digit blocks meet every tail length and overflow position.
+		std::string Text = Random() % 2 ? "-" : "";
+		const int NumDigits = 1 + static_cast<int>(Random() % 22);
+
+		for (int Index = 0; Index < NumDigits; ++Index)
+			Text.push_back(static_cast<char>('0' + Random() % 10));
+
+		errno = 0;
+		const long long Expected = std::strtoll(Text.c_str(), nullptr, 10);
+		const bool bInRange = errno != ERANGE;
+
+		int64_t Value = 0;
+		const bool bParsed = ParseInteger(Text, Min64, Max64, Value);
+
+		INI_CHECK(bParsed == bInRange && (!bParsed || Value == Expected), "'%s'", Text.c_str());
+	}
+}
+
+INI_TEST(NumberEdgeCases)
+{
+	double Value = 0.0;
+
+	INI_CHECK(ParseNumber("0", Value) && SameBits(Value, 0.0));
+	INI_CHECK(ParseNumber("-0", Value) && SameBits(Value, -0.0));
+	INI_CHECK(ParseNumber(".5", Value) && Value == 0.5);
+	INI_CHECK(ParseNumber("5.", Value) && Value == 5.0);
+	INI_CHECK(ParseNumber("1e308", Value) && Value == 1e308);
+	INI_CHECK(ParseNumber("1e309", Value) && Value == std::numeric_limits<double>::infinity());
+	INI_CHECK(ParseNumber("4.9406564584124654e-324", Value) && Value == std::numeric_limits<double>::denorm_min());
+	INI_CHECK(ParseNumber("1e-400", Value) && SameBits(Value, 0.0));
+	INI_CHECK(ParseNumber("0e99999999", Value) && SameBits(Value, 0.0));
+	INI_CHECK(ParseNumber("9007199254740993", Value) && Value == 9007199254740992.0);
+	INI_CHECK(ParseNumber("  -1.25E+2 ", Value) && Value == -125.0);
+
+	for (const char* Invalid : { "", ".", "-", "+.", "e5", "1e", "1e+", "1.2.3", "1,5", "nan", "inf", "0x1p3", "1 2" })
+		INI_CHECK(!ParseNumber(Invalid, Value), "'%s'", Invalid);
+}
+
+INI_TEST(NumbersMatchStrtod)
+{
+	std::mt19937_64 Random(2600);
+
+	for (int Iteration = 0; Iteration < 200000; ++Iteration)
+	{
+		const std::string Text = MakeDecimal(Random);
+
+		double Expected = 0.0;
+		double Value = 0.0;
+
+		INI_CHECK(ReferenceNumber(Text, Expected), "'%s'", Text.c_str());
+		INI_CHECK(ParseNumber(Text, Value) && SameBits(Value, Expected), "'%s'", Text.c_str());
+	}
+}
+
+INI_TEST(FormattedDoublesRoundTrip)
+{
+	std::mt19937_64 Random(2601);
+	char Buffer[64];
+
+	for (int Iteration = 0; Iteration < 100000; ++Iteration)
+	{
+		const double Original = RandomFiniteDouble(Random);
+
+		// Every precision a writer might use; %.17g must always give the value back.
+		for (int Precision = 1; Precision <= 17; ++Precision)
+		{
+			std::snprintf(Buffer, sizeof(Buffer), "%.*g", Precision, Original);
+
+			double Expected = 0.0;
+			double Value = 0.0;
+
+			ReferenceNumber(Buffer, Expected);
+			INI_CHECK(ParseNumber(Buffer, Value) && SameBits(Value, Expected), "'%s'", Buffer);
+			INI_CHECK(Precision < 17 || SameBits(Value, Original), "'%s'", Buffer);
+		}
+	}
+}
+
+INI_TEST(Components)
+{
+	double Values[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+	auto Parse = [&Values](const std::string& Text, const char* Keys, int NumKeys, int NumRequired)
+	{
+		return IniParserCore::ParseComponents(Text.data(), Text.data() + Text.size(), Keys, Values, NumKeys, NumRequired);
+	};
+
+	INI_CHECK(Parse("X=1 Y=2 Z=3", "XYZ", 3, 3) && Values[0] == 1.0 && Values[1] == 2.0 && Values[2] == 3.0);
+	INI_CHECK(Parse("(x=1.5,y=-2, z=3e2)", "XYZ", 3, 3) && Values[0] == 1.5 && Values[1] == -2.0 && Values[2] == 300.0);
+	INI_CHECK(Parse("P=10 Y=20 R=30", "PYR", 3, 3) && Values[2] == 30.0);
+
+	Values[3] = 1.0;
+	INI_CHECK(Parse("(R=0.5,G=0.25,B=0)", "RGBA", 4, 3) && Values[0] == 0.5 && Values[3] == 1.0);
+	INI_CHECK(Parse("(R=0.5,G=0.25,B=0,A=0.75)", "RGBA", 4, 3) && Values[3] == 0.75);
+
+	for (const char* Invalid : { "", "X=1 Y=2", "X=1 Z=2 Y=3", "X=1 Y=2 Z=3 W=4", "X=1 Y=2 Z=", "X1 Y2 Z3", "X=1 Y=2 Z=3)x" })
+		INI_CHECK(!Parse(Invalid, "XYZ", 3, 3), "'%s'", Invalid);
+}
+
+INI_TEST(FormatExamples)
+{
+	char Buffer[IniParserCore::MAX_NUMBER_LENGTH];
+
+	auto Double = [&Buffer](double Value) { IniParserCore::FormatDouble(Value, Buffer); return std::string(Buffer); };
+	auto Float = [&Buffer](float Value) { IniParserCore::FormatFloat(Value, Buffer); return std::string(Buffer); };
+
+	INI_CHECK(Double(0.1) == "0.1", "%s", Buffer);
+	INI_CHECK(Double(1.0) == "1.0", "%s", Buffer);
+	INI_CHECK(Double(-0.0) == "-0.0", "%s", Buffer);
+	INI_CHECK(Double(100.0) == "100.0", "%s", Buffer);
+	INI_CHECK(Double(1.0 / 3.0) == "0.3333333333333333", "%s", Buffer);
+	INI_CHECK(Double(1e21) == "1e+21", "%s", Buffer);
+	// Never fewer than 15 digits, so denormals keep the look of the old %.15g output.
+	INI_CHECK(Double(5e-324) == "4.94065645841247e-324", "%s", Buffer);
+	INI_CHECK(Double(std::numeric_limits<double>::infinity()) == "inf", "%s", Buffer);
+	INI_CHECK(Float(0.3f) == "0.3", "%s", Buffer);
+	INI_CHECK(Float(16777216.0f) == "16777216.0", "%s", Buffer);
+	INI_CHECK(Float(3.4028235e38f) == "3.4028235e+38", "%s", Buffer);
+}
+
+INI_TEST(FormattedDoublesAreShortestAndExact)
+{
+	std::mt19937_64 Random(27);
+	char Buffer[IniParserCore::MAX_NUMBER_LENGTH];
+	char Searched[IniParserCore::MAX_NUMBER_LENGTH];
+
+	for (int Iteration = 0; Iteration < 300000; ++Iteration)
+	{
+		// Mix arbitrary bit patterns with short decimals, which have much shorter forms.
+		const double Value = Iteration % 2 ? RandomFiniteDouble(Random) : static_cast<double>(static_cast<int64_t>(Random() % 2000000) - 1000000) / 1000.0;
+
+		IniParserCore::FormatDouble(Value, Buffer);
+		IniParserCore::FormatDouble(Value, Searched, true);
+
+		double Parsed = 0.0;
+		double Reference = 0.0;
+
+		INI_CHECK(ParseNumber(Buffer, Parsed) && SameBits(Parsed, Value), "%s", Buffer);
+		INI_CHECK(ReferenceNumber(Buffer, Reference) && SameBits(Reference, Value), "%s", Buffer);
+
+		// The precision search is exact, so the fast path must reproduce its text.
+		INI_CHECK(std::strcmp(Buffer, Searched) == 0, "%s vs %s", Buffer, Searched);
+	}
+}
+
+INI_TEST(FormattedFloatsAreShortestAndExact)
+{
+	std::mt19937_64 Random(270);
+	char Buffer[IniParserCore::MAX_NUMBER_LENGTH];
+	char Searched[IniParserCore::MAX_NUMBER_LENGTH];
+
+	for (int Iteration = 0; Iteration < 1000000; ++Iteration)
+	{
+		const uint32_t Bits = static_cast<uint32_t>(Random());
+		float Value;
+		std::memcpy(&Value, &Bits, sizeof(Value));
+
+		if (Value != Value || Value - Value != 0.0f)
+			continue;
+
+		IniParserCore::FormatFloat(Value, Buffer);
+		IniParserCore::FormatFloat(Value, Searched, true);
+
+		// Floats are read as double and narrowed, like FIniValueParser::ParseFloat and FCString::Atof.
+		double Parsed = 0.0;
+
+		INI_CHECK(ParseNumber(Buffer, Parsed) && static_cast<float>(Parsed) == Value && std::signbit(static_cast<float>(Parsed)) == std::signbit(Value), "%s", Buffer);
+		INI_CHECK(std::strcmp(Buffer, Searched) == 0, "%s vs %s", Buffer, Searched);
+	}
+}
\ No newline at end of file
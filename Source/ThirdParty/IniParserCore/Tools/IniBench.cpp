@@ -0,0 +1,661 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniParserCore/IniDocument.h"
+#include "IniParserCore/IniValues.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Heap allocations of the process so far, see IniBenchAllocations.cpp */
+extern size_t GNumAllocations;
+
+/* Throughput benchmarks for the standalone core. Each case runs at least five times and reports the fastest run, along with the heap allocations of one run. Results can be saved as a baseline and compared against it to flag regressions. */
+namespace IniBench
+{
+	struct FResult
+	{
+		std::string Name;
+		double Value;
+		std::string Unit;
+	};
+
+	static std::vector<FResult> Results;
+
+	/** Only cases whose name contains this text run */
+	static std::string Filter;
+
+	/** Smaller corpora only, for CI smoke runs */
+	static bool bQuick = false;
+
+	/** Run each case once; enough when only allocation counts are wanted */
+	static bool bSingleRun = false;
+
+	/** Keeps the compiler from dropping the measured work */
+	static volatile double Sink = 0.0;
+
+	/**
+	 * Time Body over NumItems items of NumBytes total, and record ns/item (or ItemUnit), MB/s and allocations per item
+	 *
+	 * @param Body Returns a checksum of its work
+	 * @param NumBytes 0 for cases where throughput means nothing, e.g. lookups
+	 */
+	static void Measure(const std::string& Name, size_t NumItems, size_t NumBytes, const std::function<double()>& Body, const char* ItemUnit = "ns/item")
+	{
+		if (Name.find(Filter) == std::string::npos)
+			return;
+
+		double Best = 1e300;
+		double Total = 0.0;
+		size_t NumAllocations = 0;
+
+		// At least five runs, and more for short cases until they add up to a fifth of a second.
+		for (int Run = 0; Run < (bSingleRun ? 1 : 5) || (!bSingleRun && Total < 0.2 && Run < 1000); ++Run)
+		{
+			const size_t AllocationsBefore = GNumAllocations;
+			const auto Start = std::chrono::steady_clock::now();
+			Sink = Sink + Body();
+			const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+			NumAllocations = GNumAllocations - AllocationsBefore;
+			Best = Seconds < Best ? Seconds : Best;
+			Total += Seconds;
+		}
+
+		Results.push_back({ Name, Best * 1e9 / static_cast<double>(NumItems), ItemUnit });
+
+		if (NumBytes > 0)
+			Results.push_back({ Name, static_cast<double>(NumBytes) / Best / 1e6, "MB/s" });
+
+		Results.push_back({ Name, static_cast<double>(NumAllocations) / static_cast<double>(NumItems), "allocs/item" });
+	}
+
+	static size_t TotalBytes(const std::vector<std::string>& Texts)
+	{
+		size_t NumBytes = 0;
+
+		for (const std::string& Text : Texts)
+			NumBytes += Text.size();
+
+		return NumBytes;
+	}
+
+	/** Integer, double and vector value parsing against the CRT converters the engine falls back to */
+	static void RunValues()
+	{
+		std::mt19937_64 Random(36);
+		const size_t NumValues = bQuick ? 100000 : 1000000;
+
+		std::vector<std::string> Integers;
+		std::vector<std::string> Doubles;
+		std::vector<std::string> ShortDoubles;
+		std::vector<std::string> Vectors;
+
+		char Buffer[128];
+
+		for (size_t Index = 0; Index < NumValues; ++Index)
+		{
+			// Mixed magnitudes, like real config tables.
+			const int64_t Integer = static_cast<int64_t>(Random() >> (Random() % 64));
+			Integers.emplace_back(std::to_string(Index % 2 ? -Integer : Integer));
+
+			const double Number = std::ldexp(static_cast<double>(Random() >> 11), -static_cast<int>(Random() % 80));
+
+			std::snprintf(Buffer, sizeof(Buffer), "%.17g", Number);
+			Doubles.emplace_back(Buffer);
+
+			std::snprintf(Buffer, sizeof(Buffer), "%.6g", Number);
+			ShortDoubles.emplace_back(Buffer);
+
+			std::snprintf(Buffer, sizeof(Buffer), "X=%.6g Y=%.6g Z=%.6g", Number, -Number * 0.5, Number * 3.0);
+			Vectors.emplace_back(Buffer);
+		}
+
+		Measure("values/int64 ParseIntegerValue", NumValues, TotalBytes(Integers), [&Integers]()
+		{
+			double Sum = 0.0;
+
+			for (const std::string& Text : Integers)
+			{
+				int64_t Value = 0;
+				IniParserCore::ParseIntegerValue(Text.data(), Text.data() + Text.size(), INT64_MIN, INT64_MAX, Value);
+				Sum += static_cast<double>(Value);
+			}
+
+			return Sum;
+		});
+
+		Measure("values/int64 strtoll", NumValues, TotalBytes(Integers), [&Integers]()
+		{
+			double Sum = 0.0;
+
+			for (const std::string& Text : Integers)
+				Sum += static_cast<double>(std::strtoll(Text.c_str(), nullptr, 10));
+
+			return Sum;
+		});
+
+		for (const auto& Case : { std::make_pair("values/double17", &Doubles), std::make_pair("values/double6", &ShortDoubles) })
+		{
+			const std::vector<std::string>& Texts = *Case.second;
+
+			Measure(std::string(Case.first) + " ParseNumberValue", NumValues, TotalBytes(Texts), [&Texts]()
+			{
+				double Sum = 0.0;
+
+				for (const std::string& Text : Texts)
+				{
+					double Value = 0.0;
+					IniParserCore::ParseNumberValue(Text.data(), Text.data() + Text.size(), Value);
+					Sum += Value;
+				}
+
+				return Sum;
+			});
+
+			Measure(std::string(Case.first) + " strtod", NumValues, TotalBytes(Texts), [&Texts]()
+			{
+				double Sum = 0.0;
+
+				for (const std::string& Text : Texts)
+					Sum += std::strtod(Text.c_str(), nullptr);
+
+				return Sum;
+			});
+		}
+
+		Measure("values/vector ParseComponents", NumValues, TotalBytes(Vectors), [&Vectors]()
+		{
+			double Sum = 0.0;
+
+			for (const std::string& Text : Vectors)
+			{
+				double Values[3] = { };
+				IniParserCore::ParseComponents(Text.data(), Text.data() + Text.size(), "XYZ", Values, 3, 3);
+				Sum += Values[0] + Values[1] + Values[2];
+			}
+
+			return Sum;
+		});
+
+		Measure("values/vector sscanf", NumValues, TotalBytes(Vectors), [&Vectors]()
+		{
+			double Sum = 0.0;
+
+			for (const std::string& Text : Vectors)
+			{
+				double Values[3] = { };
+				std::sscanf(Text.c_str(), "X=%lf Y=%lf Z=%lf", &Values[0], &Values[1], &Values[2]);
+				Sum += Values[0] + Values[1] + Values[2];
+			}
+
+			return Sum;
+		});
+	}
+
+	/** Shortest round-trip double formatting against the fixed-precision printf the engine used before */
+	static void RunFormatting()
+	{
+		std::mt19937_64 Random(27);
+		const size_t NumValues = bQuick ? 100000 : 1000000;
+
+		std::vector<double> Numbers;
+
+		for (size_t Index = 0; Index < NumValues; ++Index)
+			Numbers.push_back(std::ldexp(static_cast<double>(Random() >> 11), -static_cast<int>(Random() % 80)));
+
+		const auto MeasureFormat = [&Numbers](const char* Name, const std::function<int(double, char*)>& Format)
+		{
+			size_t NumBytes = 0;
+			char Buffer[IniParserCore::MAX_NUMBER_LENGTH];
+
+			for (double Number : Numbers)
+				NumBytes += static_cast<size_t>(Format(Number, Buffer));
+
+			Measure(Name, Numbers.size(), NumBytes, [&Numbers, &Format]()
+			{
+				double Sum = 0.0;
+				char Buffer[IniParserCore::MAX_NUMBER_LENGTH];
+
+				for (double Number : Numbers)
+					Sum += Format(Number, Buffer);
+
+				return Sum;
+			});
+		};
+
+		MeasureFormat("format/double FormatDouble", [](double Value, char* Buffer) { return IniParserCore::FormatDouble(Value, Buffer); });
+		MeasureFormat("format/double FormatDouble search", [](double Value, char* Buffer) { return IniParserCore::FormatDouble(Value, Buffer, true); });
+		MeasureFormat("format/double snprintf %.17g", [](double Value, char* Buffer) { return std::snprintf(Buffer, IniParserCore::MAX_NUMBER_LENGTH, "%.17g", Value); });
+	}
+
+	/** Layouts of the synthetic corpora */
+	enum class EShape
+	{
+		/** Game-config style: many small sections of mixed scalars, vectors and quoted strings, with comments */
+		Config,
+
+		/** One huge section */
+		Flat,
+
+		/** "+Key=Element" arrays */
+		Arrays,
+
+		/** Config layout with multi-byte UTF-8 in comments and values */
+		Unicode,
+	};
+
+	static const char* GetShapeName(EShape Shape)
+	{
+		switch (Shape)
+		{
+			case EShape::Config: return "config";
+			case EShape::Flat: return "flat";
+			case EShape::Arrays: return "arrays";
+			default: return "unicode";
+		}
+	}
+
+	/** Deterministic corpus of roughly TargetBytes bytes */
+	static std::string MakeCorpus(EShape Shape, size_t TargetBytes)
+	{
+		const int PropertiesPerSection = Shape == EShape::Flat ? 1 << 30 : 32;
+		const char* Text = Shape == EShape::Unicode ? "Grüße aus Zürich, 東京タワー" : "Entry of the section";
+
+		std::string Corpus;
+		char Buffer[256];
+		int Section = -1;
+
+		for (int Index = 0; Corpus.size() < TargetBytes; ++Index)
+		{
+			if (Index % PropertiesPerSection == 0)
+			{
+				Corpus += Section >= 0 ? "\n" : "";
+				std::snprintf(Buffer, sizeof(Buffer), "[/Script/Game.Section%d]\n", ++Section);
+				Corpus += Buffer;
+			}
+
+			if (Index % 8 == 0)
+			{
+				std::snprintf(Buffer, sizeof(Buffer), "; %s, block %d\n", Text, Index / 8);
+				Corpus += Buffer;
+			}
+
+			if (Shape == EShape::Arrays)
+			{
+				for (int Element = 0; Element < 8; ++Element)
+				{
+					std::snprintf(Buffer, sizeof(Buffer), "+Items%d=(Id=%d,Weight=%d.5)\n", Index, Element, Index % 100);
+					Corpus += Buffer;
+				}
+
+				continue;
+			}
+
+			switch (Index % 4)
+			{
+				case 0: std::snprintf(Buffer, sizeof(Buffer), "Count%d=%d\n", Index, Index * 37 - 500); break;
+				case 1: std::snprintf(Buffer, sizeof(Buffer), "Scale%d=%.6g\n", Index, Index * 0.125 + Section); break;
+				case 2: std::snprintf(Buffer, sizeof(Buffer), "Offset%d=X=%d.5 Y=%d.25 Z=-%d\n", Index, Index, Section, Index); break;
+				default: std::snprintf(Buffer, sizeof(Buffer), "Name%d=\"%s %d\"\n", Index, Text, Index); break;
+			}
+
+			Corpus += Buffer;
+		}
+
+		return Corpus;
+	}
+
+	/** UTF-8 to UTF-16, like the TCHAR text Unreal parses */
+	static std::u16string Widen(const std::string& Text)
+	{
+		std::u16string Wide;
+		Wide.reserve(Text.size());
+
+		for (size_t Index = 0; Index < Text.size();)
+		{
+			const unsigned char Lead = static_cast<unsigned char>(Text[Index]);
+			const size_t Len = Lead < 0x80 ? 1 : Lead < 0xE0 ? 2 : Lead < 0xF0 ? 3 : 4;
+			uint32_t CodePoint = Len == 1 ? Lead : Lead & (0x3F >> (Len - 1));
+
+			for (size_t Continuation = 1; Continuation < Len && Index + Continuation < Text.size(); ++Continuation)
+				CodePoint = (CodePoint << 6) | (static_cast<unsigned char>(Text[Index + Continuation]) & 0x3F);
+
+			if (CodePoint >= 0x10000)
+			{
+				Wide.push_back(static_cast<char16_t>(0xD800 + ((CodePoint - 0x10000) >> 10)));
+				Wide.push_back(static_cast<char16_t>(0xDC00 + ((CodePoint - 0x10000) & 0x3FF)));
+			}
+			else
+				Wide.push_back(static_cast<char16_t>(CodePoint));
+
+			Index += Len;
+		}
+
+		return Wide;
+	}
+
+	/** Counts tokens without storing them, to time the tokenizer alone */
+	template <typename CharT>
+	struct TCountingHandler
+	{
+		size_t NumTokens = 0;
+
+		void OnComment(IniParserCore::TSpan<CharT>) { ++NumTokens; }
+		void OnSection(IniParserCore::TSpan<CharT>) { ++NumTokens; }
+		void OnProperty(IniParserCore::TSpan<CharT>, IniParserCore::TSpan<CharT>) { ++NumTokens; }
+	};
+
+	static std::string ReadFile(const std::filesystem::path& Path)
+	{
+		std::ifstream Stream(Path, std::ios::binary);
+		std::ostringstream Buffer;
+		Buffer << Stream.rdbuf();
+		return Buffer.str();
+	}
+
+	/** The core equivalents of ParseIniFromString, ParseIniToString, ReadIniFromFile, WriteIniToFile and the typed getters */
+	static void RunDocuments()
+	{
+		const std::filesystem::path FilePath = std::filesystem::temp_directory_path() / "iniparser-bench.ini";
+		std::vector<size_t> Sizes = { 64 << 10, 1 << 20 };
+
+		if (!bQuick)
+			Sizes.push_back(16 << 20);
+
+		for (EShape Shape : { EShape::Config, EShape::Flat, EShape::Arrays, EShape::Unicode })
+		{
+			for (size_t Size : Sizes)
+			{
+				char Prefix[64];
+				std::snprintf(Prefix, sizeof(Prefix), "doc/%s/%zuk ", GetShapeName(Shape), Size >> 10);
+
+				const std::string Corpus = MakeCorpus(Shape, Size);
+				const std::u16string WideCorpus = Widen(Corpus);
+
+				TCountingHandler<char> Counter;
+				IniParserCore::Tokenize(Corpus.data(), Corpus.data() + Corpus.size(), Counter);
+				const size_t NumTokens = Counter.NumTokens;
+
+				Measure(Prefix + std::string("tokenize utf8"), NumTokens, Corpus.size(), [&Corpus]()
+				{
+					TCountingHandler<char> Handler;
+					IniParserCore::Tokenize(Corpus.data(), Corpus.data() + Corpus.size(), Handler);
+					return static_cast<double>(Handler.NumTokens);
+				});
+
+				Measure(Prefix + std::string("tokenize utf16"), NumTokens, WideCorpus.size() * sizeof(char16_t), [&WideCorpus]()
+				{
+					TCountingHandler<char16_t> Handler;
+					IniParserCore::Tokenize(WideCorpus.data(), WideCorpus.data() + WideCorpus.size(), Handler);
+					return static_cast<double>(Handler.NumTokens);
+				});
+
+				Measure(Prefix + std::string("parse"), NumTokens, Corpus.size(), [&Corpus]()
+				{
+					return static_cast<double>(IniParserCore::FDocument::Parse(Corpus).Sections.size());
+				});
+
+				const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse(Corpus);
+				const size_t NumSerialized = Document.Serialize().size();
+
+				Measure(Prefix + std::string("serialize"), NumTokens, NumSerialized, [&Document]()
+				{
+					return static_cast<double>(Document.Serialize().size());
+				});
+
+				Measure(Prefix + std::string("write file"), NumTokens, NumSerialized, [&Document, &FilePath]()
+				{
+					const std::string Text = Document.Serialize();
+					std::ofstream(FilePath, std::ios::binary).write(Text.data(), static_cast<std::streamsize>(Text.size()));
+					return static_cast<double>(Text.size());
+				});
+
+				Measure(Prefix + std::string("read file"), NumTokens, NumSerialized, [&FilePath]()
+				{
+					return static_cast<double>(IniParserCore::FDocument::Parse(ReadFile(FilePath)).Sections.size());
+				});
+
+				// Every key once, in random order, so the lookups do not walk memory linearly.
+				std::vector<std::pair<const IniParserCore::FSection*, const IniParserCore::FProperty*>> Keys;
+
+				for (const IniParserCore::FSection& Section : Document.Sections)
+				{
+					for (const IniParserCore::FProperty& Property : Section.Properties)
+						Keys.emplace_back(&Section, &Property);
+				}
+
+				std::shuffle(Keys.begin(), Keys.end(), std::mt19937_64(36));
+
+				Measure(Prefix + std::string("lookup"), Keys.size(), 0, [&Document, &Keys]()
+				{
+					double Sum = 0.0;
+
+					for (const auto& Key : Keys)
+					{
+						const IniParserCore::FSection* Section = Document.FindSection(Key.first->Name);
+						Sum += Section && Section->FindProperty(Key.second->Key) ? 1.0 : 0.0;
+					}
+
+					return Sum;
+				}, "ns/lookup");
+
+				Measure(Prefix + std::string("getters"), Keys.size(), 0, [&Document, &Keys]()
+				{
+					double Sum = 0.0;
+
+					for (const auto& Key : Keys)
+					{
+						const IniParserCore::FSection* Section = Document.FindSection(Key.first->Name);
+						const IniParserCore::FProperty* Property = Section ? Section->FindProperty(Key.second->Key) : nullptr;
+
+						if (Property == nullptr || Property->IsArray())
+							continue;
+
+						const char* Begin = Property->Value.data();
+						const char* End = Begin + Property->Value.size();
+
+						// Read each value as the type its key stands for, like the typed UIniLibrary getters.
+						switch (Property->Key[0])
+						{
+							case 'C':
+							{
+								int64_t Value = 0;
+								IniParserCore::ParseIntegerValue(Begin, End, INT32_MIN, INT32_MAX, Value);
+								Sum += static_cast<double>(Value);
+								break;
+							}
+
+							case 'S':
+							{
+								double Value = 0.0;
+								IniParserCore::ParseNumberValue(Begin, End, Value);
+								Sum += Value;
+								break;
+							}
+
+							case 'O':
+							{
+								double Values[3] = { };
+								IniParserCore::ParseComponents(Begin, End, "XYZ", Values, 3, 3);
+								Sum += Values[0];
+								break;
+							}
+
+							default:
+								Sum += static_cast<double>(Property->Value.size());
+								break;
+						}
+					}
+
+					return Sum;
+				}, "ns/lookup");
+			}
+		}
+
+		std::error_code Ignored;
+		std::filesystem::remove(FilePath, Ignored);
+	}
+
+	/** "<value> <unit> <name>" per line */
+	static bool WriteBaseline(const char* Path)
+	{
+		std::ofstream Stream(Path);
+
+		for (const FResult& Result : Results)
+		{
+			char Line[256];
+			std::snprintf(Line, sizeof(Line), "%.9g %s %s\n", Result.Value, Result.Unit.c_str(), Result.Name.c_str());
+			Stream << Line;
+		}
+
+		return static_cast<bool>(Stream);
+	}
+
+	/**
+	 * Compare the results with a baseline and print every case that got worse by more than Tolerance (a fraction).
+	 * Lower MB/s is worse; for every other unit higher is worse. Cases missing from either side are skipped.
+	 *
+	 * @return Number of regressions, or -1 if the baseline can not be read
+	 */
+	static int CompareBaseline(const char* Path, double Tolerance)
+	{
+		std::ifstream Stream(Path);
+
+		if (!Stream)
+			return -1;
+
+		std::map<std::string, double> Baseline;
+		std::string Line;
+
+		while (std::getline(Stream, Line))
+		{
+			double Value;
+			char Unit[32];
+			int NameStart = 0;
+
+			if (std::sscanf(Line.c_str(), "%lf %31s %n", &Value, Unit, &NameStart) == 2 && NameStart > 0)
+				Baseline[Line.substr(static_cast<size_t>(NameStart)) + " " + Unit] = Value;
+		}
+
+		int NumRegressions = 0;
+
+		for (const FResult& Result : Results)
+		{
+			const auto Found = Baseline.find(Result.Name + " " + Result.Unit);
+
+			if (Found == Baseline.end())
+				continue;
+
+			const double Before = Found->second;
+			const bool bHigherIsBetter = Result.Unit == "MB/s";
+
+			// Allocation counts of zero must stay zero; timings of zero do not happen.
+			const bool bRegressed = bHigherIsBetter
+				? Result.Value < Before * (1.0 - Tolerance)
+				: Result.Value > Before * (1.0 + Tolerance) + (Result.Unit == "allocs/item" ? 1e-9 : 0.0);
+
+			if (bRegressed)
+			{
+				std::printf("REGRESSION %-48s %12.2f %s (baseline %.2f)\n", Result.Name.c_str(), Result.Value, Result.Unit.c_str(), Before);
+				++NumRegressions;
+			}
+		}
+
+		return NumRegressions;
+	}
+}
+
+static void PrintUsage()
+{
+	std::fprintf(stderr,
+		"Usage:\n"
+		"  iniparser-bench [options]\n"
+		"    --filter <text>            Only run cases whose name contains the text\n"
+		"    --quick                    Smaller corpora, for CI smoke runs\n"
+		"    --only <unit>              Only print, save and compare results in this unit (ns/item, ns/lookup, MB/s, allocs/item)\n"
+		"    --write-baseline <file>    Save the results\n"
+		"    --baseline <file>          Compare with saved results; exit code 1 on regressions\n"
+		"    --tolerance <percent>      Allowed slowdown before a case counts as a regression (default 15)\n");
+}
+
+int main(int Argc, char** Argv)
+{
+	const char* BaselinePath = nullptr;
+	const char* WriteBaselinePath = nullptr;
+	const char* OnlyUnit = nullptr;
+	double Tolerance = 0.15;
+
+	for (int Index = 1; Index < Argc; ++Index)
+	{
+		const std::string Arg = Argv[Index];
+		const bool bHasValue = Index + 1 < Argc;
+
+		if (Arg == "--quick")
+			IniBench::bQuick = true;
+		else if (Arg == "--filter" && bHasValue)
+			IniBench::Filter = Argv[++Index];
+		else if (Arg == "--only" && bHasValue)
+			OnlyUnit = Argv[++Index];
+		else if (Arg == "--baseline" && bHasValue)
+			BaselinePath = Argv[++Index];
+		else if (Arg == "--write-baseline" && bHasValue)
+			WriteBaselinePath = Argv[++Index];
+		else if (Arg == "--tolerance" && bHasValue)
+			Tolerance = std::atof(Argv[++Index]) / 100.0;
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	// Allocation counts are the same on every run.
+	IniBench::bSingleRun = OnlyUnit && std::strcmp(OnlyUnit, "allocs/item") == 0;
+
+	IniBench::RunValues();
+	IniBench::RunFormatting();
+	IniBench::RunDocuments();
+
+	if (OnlyUnit)
+	{
+		std::vector<IniBench::FResult>& Results = IniBench::Results;
+		Results.erase(std::remove_if(Results.begin(), Results.end(), [OnlyUnit](const IniBench::FResult& Result) { return Result.Unit != OnlyUnit; }), Results.end());
+	}
+
+	for (const IniBench::FResult& Result : IniBench::Results)
+		std::printf("%-48s %12.2f %s\n", Result.Name.c_str(), Result.Value, Result.Unit.c_str());
+
+	if (WriteBaselinePath && !IniBench::WriteBaseline(WriteBaselinePath))
+	{
+		std::fprintf(stderr, "ERROR: Can not write the baseline: %s\n", WriteBaselinePath);
+		return 1;
+	}
+
+	if (BaselinePath)
+	{
+		const int NumRegressions = IniBench::CompareBaseline(BaselinePath, Tolerance);
+
+		if (NumRegressions < 0)
+		{
+			std::fprintf(stderr, "ERROR: Can not read the baseline: %s\n", BaselinePath);
+			return 1;
+		}
+
+		if (NumRegressions > 0)
+			return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
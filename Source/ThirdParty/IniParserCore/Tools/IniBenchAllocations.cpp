@@ -0,0 +1,28 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/* Counts every heap allocation of iniparser-bench, which is single-threaded. Kept out of IniBench.cpp so these never inline into the benchmarks, where GCC mistakes the malloc/free pair for a mismatch. */
+size_t GNumAllocations = 0;
+
+void* operator new(size_t Size)
+{
+	++GNumAllocations;
+
+	if (void* Memory = std::malloc(Size ? Size : 1))
+		return Memory;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* Memory) noexcept
+{
+	std::free(Memory);
+}
+
+void operator delete(void* Memory, size_t) noexcept
+{
+	std::free(Memory);
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniParserCore/IniDiagnostics.h"
+#include "IniParserCore/IniDocument.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static void PrintUsage()
+{
+	std::fprintf(stderr,
+		"Usage:\n"
+		"  iniparser-cli <file>                      Print the normalized document\n"
+		"  iniparser-cli <file> --get <section> <key> Print one value, or each array element (use \"\" as section for globals)\n"
+		"  iniparser-cli <file> --stats              Print section, property and comment counts\n"
+		"  iniparser-cli <file> --check              Print malformed lines as file:line:column; exit code 1 on errors\n"
+		"  iniparser-cli <file> --roundtrip          Check that parse/serialize is stable; aborts otherwise (usable as an AFL target)\n");
+}
+
+static bool ReadFile(const char* Path, std::string& OutText)
+{
+	std::ifstream Stream(Path, std::ios::binary);
+
+	if (!Stream)
+		return false;
+
+	std::ostringstream Buffer;
+	Buffer << Stream.rdbuf();
+	OutText = Buffer.str();
+	return true;
+}
+
+/* Reports malformed lines and ignores everything else */
+struct FCheckHandler
+{
+	typedef IniParserCore::TSpan<char> FSpan;
+
+	const char* Path;
+	IniParserCore::TLineLocator<char> Locator;
+	int NumErrors = 0;
+
+	void OnComment(FSpan) { }
+	void OnSection(FSpan) { }
+	void OnProperty(FSpan, FSpan) { }
+
+	void OnError(IniParserCore::ELineError Error, const char* At)
+	{
+		int Line, Column;
+		Locator.Locate(At, Line, Column);
+
+		const bool bWarning = IniParserCore::IsWarning(Error);
+		NumErrors += bWarning ? 0 : 1;
+
+		std::fprintf(stderr, "%s:%d:%d: %s: %s\n", Path, Line, Column, bWarning ? "warning" : "error", IniParserCore::GetErrorMessage(Error));
+	}
+};
+
+int main(int Argc, char** Argv)
+{
+	if (Argc < 2)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	std::string Text;
+
+	if (!ReadFile(Argv[1], Text))
+	{
+		std::fprintf(stderr, "ERROR: Can not read the file: %s\n", Argv[1]);
+		return 1;
+	}
+
+	const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse(Text);
+
+	if (Argc == 2)
+	{
+		const std::string Out = Document.Serialize();
+		std::fwrite(Out.data(), 1, Out.size(), stdout);
+		std::fputc('\n', stdout);
+		return 0;
+	}
+
+	const std::string Command = Argv[2];
+
+	if (Command == "--get" && Argc == 5)
+	{
+		const std::string Section = Argv[3];
+		const IniParserCore::FSection* Found = Section.empty() ? &Document.Global : Document.FindSection(Section);
+		const IniParserCore::FProperty* Property = Found ? Found->FindProperty(Argv[4]) : nullptr;
+
+		if (!Property)
+			return 1;
+
+		if (!Property->IsArray())
+			std::printf("%s\n", Property->Value.c_str());
+
+		// One element per line
+		for (const std::string& Element : Property->Values)
+			std::printf("%s\n", Element.c_str());
+
+		return 0;
+	}
+
+	if (Command == "--stats" && Argc == 3)
+	{
+		size_t NumProperties = Document.Global.Properties.size();
+		size_t NumComments = Document.Global.Comments.size();
+
+		for (const IniParserCore::FSection& Section : Document.Sections)
+		{
+			NumProperties += Section.Properties.size();
+			NumComments += Section.Comments.size();
+		}
+
+		std::printf("sections=%zu properties=%zu comments=%zu bytes=%zu\n", Document.Sections.size(), NumProperties, NumComments, Text.size());
+		return 0;
+	}
+
+	if (Command == "--check" && Argc == 3)
+	{
+		FCheckHandler Handler{ Argv[1], IniParserCore::TLineLocator<char>(Text.data()) };
+		IniParserCore::Tokenize(Text.data(), Text.data() + Text.size(), Handler);
+
+		return Handler.NumErrors > 0 ? 1 : 0;
+	}
+
+	if (Command == "--roundtrip" && Argc == 3)
+	{
+		// Serializing and parsing again must give the same text; abort so fuzzers record the input.
+		const std::string First = Document.Serialize();
+		const std::string Second = IniParserCore::FDocument::Parse(First).Serialize();
+
+		if (First != Second)
+		{
+			std::fprintf(stderr, "ERROR: Round-trip mismatch\n--- first ---\n%s\n--- second ---\n%s\n", First.c_str(), Second.c_str());
+			std::abort();
+		}
+
+		return 0;
+	}
+
+	PrintUsage();
+	return 2;
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#include "IniParserCore/IniDocument.h"
+#include "IniParserCore/IniTokenizer.h"
+#include "IniParserCore/IniWriter.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Checks run on every input. A failed check prints what differed and aborts, so libFuzzer and AFL record the input as a crash. */
+namespace IniFuzz
+{
+	/* One handler callback, as offsets into the whole input so runs over different buffers compare */
+	struct FEvent
+	{
+		char Kind;
+		size_t Begin;
+		size_t End;
+
+		bool operator==(const FEvent& Other) const { return Kind == Other.Kind && Begin == Other.Begin && End == Other.End; }
+	};
+
+	template <typename CharT>
+	struct TRecorder
+	{
+		typedef IniParserCore::TSpan<CharT> FSpan;
+
+		std::vector<FEvent>& Events;
+
+		/** Start of the buffer being tokenized, and where that buffer starts in the whole input */
+		const CharT* Base;
+		size_t BaseOffset;
+
+		void OnComment(FSpan Text) { Add('C', Text); }
+		void OnSection(FSpan Name) { Add('S', Name); }
+
+		void OnProperty(FSpan Key, FSpan RawValue)
+		{
+			Add('K', Key);
+			Add('V', RawValue);
+		}
+
+		void OnError(IniParserCore::ELineError Error, const CharT* At)
+		{
+			Events.push_back({ static_cast<char>('0' + static_cast<int>(Error)), ToOffset(At), ToOffset(At) });
+		}
+
+		size_t ToOffset(const CharT* At) const { return BaseOffset + static_cast<size_t>(At - Base); }
+
+		void Add(char Kind, FSpan Span) { Events.push_back({ Kind, ToOffset(Span.Begin), ToOffset(Span.End) }); }
+	};
+
+	template <typename CharT>
+	static std::vector<FEvent> TokenizeWhole(const std::basic_string<CharT>& Text)
+	{
+		std::vector<FEvent> Events;
+		TRecorder<CharT> Recorder{ Events, Text.data(), 0 };
+
+		IniParserCore::Tokenize(Text.data(), Text.data() + Text.size(), Recorder);
+		return Events;
+	}
+
+	/* Feed the text ChunkSize bytes at a time and carry the unfinished tail over, the way FIniCompression::ReadFromFile decodes chunks */
+	static std::vector<FEvent> TokenizeChunked(const std::string& Text, size_t ChunkSize)
+	{
+		std::vector<FEvent> Events;
+		std::string Window;
+		size_t WindowOffset = 0;
+
+		for (size_t Offset = 0; Offset < Text.size(); Offset += ChunkSize)
+		{
+			Window.append(Text, Offset, ChunkSize);
+
+			TRecorder<char> Recorder{ Events, Window.data(), WindowOffset };
+			const char* Begin = Window.data();
+			const char* End = Begin + Window.size();
+
+			if (Offset + ChunkSize < Text.size())
+			{
+				const char* Tail = IniParserCore::TokenizeComplete(Begin, End, Recorder);
+
+				WindowOffset += static_cast<size_t>(Tail - Begin);
+				Window.erase(0, static_cast<size_t>(Tail - Begin));
+			}
+			else
+			{
+				IniParserCore::Tokenize(Begin, End, Recorder);
+			}
+		}
+
+		return Events;
+	}
+
+	static void Fail(const char* Check, const std::string& Input, const std::string& Detail)
+	{
+		std::fprintf(stderr, "ERROR: %s\n--- input (%zu bytes) ---\n%s\n--- detail ---\n%s\n", Check, Input.size(), Input.c_str(), Detail.c_str());
+		std::abort();
+	}
+
+	static std::string Describe(const std::vector<FEvent>& Events)
+	{
+		std::string Out;
+
+		for (const FEvent& Event : Events)
+			Out += Event.Kind + std::string(" ") + std::to_string(Event.Begin) + "-" + std::to_string(Event.End) + "\n";
+
+		return Out;
+	}
+
+	static bool IsWritable(const std::string& Value)
+	{
+		return IniParserCore::IsWritable(IniParserCore::TSpan<char>{ Value.data(), Value.data() + Value.size() });
+	}
+
+	static void Check(const std::string& Input)
+	{
+		const IniParserCore::FDocument Document = IniParserCore::FDocument::Parse(Input);
+
+		// Parsed values must always be writable, or Serialize would leave them out.
+		const auto CheckWritable = [&Input](const IniParserCore::FSection& Section)
+		{
+			for (const IniParserCore::FProperty& Property : Section.Properties)
+			{
+				bool bWritable = IsWritable(Property.Value);
+
+				for (const std::string& Element : Property.Values)
+					bWritable &= IsWritable(Element);
+
+				if (!bWritable)
+					Fail("Parsed value is not writable", Input, "[" + Section.Name + "] " + Property.Key);
+			}
+		};
+
+		CheckWritable(Document.Global);
+
+		for (const IniParserCore::FSection& Section : Document.Sections)
+			CheckWritable(Section);
+
+		// Serializing must reach a fixed point after one parse: the written text parses back to the same document.
+		const std::string First = Document.Serialize();
+		const std::string Second = IniParserCore::FDocument::Parse(First).Serialize();
+
+		if (First != Second)
+			Fail("Round-trip mismatch", Input, "--- first ---\n" + First + "\n--- second ---\n" + Second);
+
+		// Chunked tokenizing must report exactly what tokenizing the whole text reports, wherever the chunks are cut.
+		const std::vector<FEvent> Whole = TokenizeWhole(Input);
+
+		for (size_t ChunkSize : { 1, 2, 3, 7, 64 })
+		{
+			if (ChunkSize >= Input.size())
+				break;
+
+			const std::vector<FEvent> Chunked = TokenizeChunked(Input, ChunkSize);
+
+			if (Chunked != Whole)
+				Fail(("Chunked tokenizing differs, chunk size " + std::to_string(ChunkSize)).c_str(), Input, "--- whole ---\n" + Describe(Whole) + "--- chunked ---\n" + Describe(Chunked));
+		}
+
+		// The tokenizer only looks at ASCII, so widening every byte must not change a single event.
+		const std::u16string Wide(Input.begin(), Input.end());
+		const std::vector<FEvent> WideEvents = TokenizeWhole(Wide);
+
+		if (WideEvents != Whole)
+			Fail("char16_t tokenizing differs", Input, "--- char ---\n" + Describe(Whole) + "--- char16_t ---\n" + Describe(WideEvents));
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* Data, size_t Size)
+{
+	IniFuzz::Check(std::string(reinterpret_cast<const char*>(Data), Size));
+	return 0;
+}
+
+#ifndef INIPARSER_LIBFUZZER
+
+static void PrintUsage()
+{
+	std::fprintf(stderr,
+		"Usage:\n"
+		"  iniparser-fuzz <file or directory>...   Check every file (AFL: afl-fuzz -i <corpus> -o <findings> -- iniparser-fuzz @@)\n"
+		"  iniparser-fuzz                          Check stdin\n"
+		"  iniparser-fuzz --random <count> [seed]  Check random inputs built from .ini syntax characters\n");
+}
+
+static bool CheckFile(const std::filesystem::path& Path)
+{
+	std::ifstream Stream(Path, std::ios::binary);
+
+	if (!Stream)
+	{
+		std::fprintf(stderr, "ERROR: Can not read the file: %s\n", Path.string().c_str());
+		return false;
+	}
+
+	IniFuzz::Check(std::string(std::istreambuf_iterator<char>(Stream), std::istreambuf_iterator<char>()));
+	return true;
+}
+
+int main(int Argc, char** Argv)
+{
+	if (Argc == 1)
+	{
+		std::cin >> std::noskipws;
+		IniFuzz::Check(std::string(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>()));
+		return 0;
+	}
+
+	if (std::strcmp(Argv[1], "--random") == 0)
+	{
+		if (Argc < 3 || Argc > 4)
+		{
+			PrintUsage();
+			return 2;
+		}
+
+		// Mostly syntax characters, so short inputs still hit quotes, continuations, sections and array operators.
+		static const char Alphabet[] = "ab \t=[];\"'\n\r\nx1.\\+-";
+		std::mt19937 Random(Argc == 4 ? static_cast<unsigned>(std::strtoul(Argv[3], nullptr, 10)) : 46u);
+		std::uniform_int_distribution<size_t> Length(0, 120);
+		std::uniform_int_distribution<size_t> Letter(0, sizeof(Alphabet) - 2);
+
+		const long Count = std::strtol(Argv[2], nullptr, 10);
+
+		for (long Index = 0; Index < Count; ++Index)
+		{
+			std::string Input(Length(Random), ' ');
+
+			for (char& Char : Input)
+				Char = Alphabet[Letter(Random)];
+
+			IniFuzz::Check(Input);
+		}
+
+		std::printf("%ld random inputs passed\n", Count);
+		return 0;
+	}
+
+	size_t NumFiles = 0;
+
+	for (int Index = 1; Index < Argc; ++Index)
+	{
+		const std::filesystem::path Path(Argv[Index]);
+
+		if (!std::filesystem::is_directory(Path))
+		{
+			if (!CheckFile(Path))
+				return 1;
+
+			++NumFiles;
+			continue;
+		}
+
+		for (const auto& Entry : std::filesystem::recursive_directory_iterator(Path))
+		{
+			if (!Entry.is_regular_file())
+				continue;
+
+			if (!CheckFile(Entry.path()))
+				return 1;
+
+			++NumFiles;
+		}
+	}
+
+	std::printf("%zu inputs passed\n", NumFiles);
+	return 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "IniParserCore/IniTokenizer.h"
+
+/* Helpers for reporting ELineError. Nothing here runs unless a line is malformed. */
+namespace IniParserCore
+{
+	inline bool IsWarning(ELineError Error)
+	{
+		return Error == ELineError::TrailingTextAfterSection;
+	}
+
+	inline const char* GetErrorMessage(ELineError Error)
+	{
+		switch (Error)
+		{
+			case ELineError::MissingSectionClose: return "Section header is missing ']', line ignored";
+			case ELineError::TrailingTextAfterSection: return "Text after ']' is ignored";
+			case ELineError::MissingEquals: return "Expected 'Key=Value', line ignored";
+			case ELineError::EmptyKey: return "Property has no key, line ignored";
+			case ELineError::UnterminatedQuote: return "Quoted value is never closed, only this line is read";
+		}
+
+		return "Unknown error";
+	}
+
+	/**
+	 * Turns a position in the source into a 1-based line and column. Lines are counted from the previous lookup,
+	 * so locating errors in source order costs one pass over the text in total.
+	 */
+	template <typename CharT>
+	class TLineLocator
+	{
+	public:
+		explicit TLineLocator(const CharT* InBegin)
+			: Begin(InBegin)
+			, Cursor(InBegin)
+			, LineStart(InBegin)
+		{ }
+
+		void Locate(const CharT* At, int& OutLine, int& OutColumn)
+		{
+			// Restart if asked about an earlier position.
+			if (At < Cursor)
+			{
+				Cursor = Begin;
+				LineStart = Begin;
+				Line = 1;
+			}
+
+			for (; Cursor < At; ++Cursor)
+			{
+				if (*Cursor == CharT('\n'))
+				{
+					++Line;
+					LineStart = Cursor + 1;
+				}
+			}
+
+			OutLine = Line;
+			OutColumn = static_cast<int>(At - LineStart) + 1;
+		}
+
+	private:
+		const CharT* Begin;
+		const CharT* Cursor;
+		const CharT* LineStart;
+		int Line = 1;
+	};
+}
\ No newline at end of file
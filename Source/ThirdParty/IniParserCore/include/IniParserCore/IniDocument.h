@@ -0,0 +1,275 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "IniParserCore/IniTokenizer.h"
+#include "IniParserCore/IniWriter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/* Engine-independent .ini document for tools and servers that do not link Unreal. Keys and section names are case-insensitive like FName; entries keep their file order. */
+namespace IniParserCore
+{
+	struct FProperty
+	{
+		std::string Key;
+		std::string Value;
+
+		/** Elements of an array property ("+Key=..." lines); Value is empty then */
+		std::vector<std::string> Values;
+
+		bool IsArray() const { return !Values.empty(); }
+
+		/** A plain value set before the first element becomes the first element, as in Unreal */
+		void AddValue(std::string_view Element)
+		{
+			if (Values.empty() && !Value.empty())
+				Values.push_back(std::move(Value));
+
+			Value.clear();
+			Values.emplace_back(Element);
+		}
+
+		void RemoveValue(std::string_view Element)
+		{
+			if (Values.empty())
+			{
+				if (Value == Element)
+					Value.clear();
+
+				return;
+			}
+
+			Values.erase(std::remove(Values.begin(), Values.end(), Element), Values.end());
+		}
+	};
+
+	class FSection
+	{
+	public:
+		std::string Name;
+		std::vector<std::string> Comments;
+		std::vector<FProperty> Properties;
+
+	public:
+		const FProperty* FindProperty(std::string_view Key) const
+		{
+			const auto Found = Index.find(ToLower(Key));
+			return Found != Index.end() ? &Properties[Found->second] : nullptr;
+		}
+
+		FProperty* FindProperty(std::string_view Key)
+		{
+			const auto Found = Index.find(ToLower(Key));
+			return Found != Index.end() ? &Properties[Found->second] : nullptr;
+		}
+
+		/** Adds the property if missing; an existing value is kept, like FIniSection::FindOrAddProperty. */
+		FProperty& FindOrAddProperty(std::string_view Key, std::string_view Value)
+		{
+			const auto Inserted = Index.emplace(ToLower(Key), Properties.size());
+
+			if (Inserted.second)
+				Properties.push_back({ std::string(Key), std::string(Value), {} });
+
+			return Properties[Inserted.first->second];
+		}
+
+		static std::string ToLower(std::string_view Text)
+		{
+			std::string Lower(Text);
+
+			for (char& Char : Lower)
+				Char = static_cast<char>(std::tolower(static_cast<unsigned char>(Char)));
+
+			return Lower;
+		}
+
+	private:
+		std::unordered_map<std::string, size_t> Index;
+	};
+
+	class FDocument
+	{
+	public:
+		/** Global comments and properties */
+		FSection Global;
+		std::vector<FSection> Sections;
+
+	public:
+		const FSection* FindSection(std::string_view Name) const
+		{
+			const auto Found = Index.find(FSection::ToLower(Name));
+			return Found != Index.end() ? &Sections[Found->second] : nullptr;
+		}
+
+		FSection& FindOrAddSection(std::string_view Name)
+		{
+			const auto Inserted = Index.emplace(FSection::ToLower(Name), Sections.size());
+
+			if (Inserted.second)
+			{
+				Sections.emplace_back();
+				Sections.back().Name = std::string(Name);
+			}
+
+			return Sections[Inserted.first->second];
+		}
+
+		static FDocument Parse(std::string_view Text)
+		{
+			FDocument Document;
+			FBuilder Builder{ Document, &Document.Global };
+
+			Tokenize(Text.data(), Text.data() + Text.size(), Builder);
+			return Document;
+		}
+
+		/** Same layout as UIniLibrary::ParseIniToString. Properties with a value that can not be written are left out (see IsWritable). */
+		std::string Serialize() const
+		{
+			std::string Out;
+			FStringSink Sink{ Out };
+
+			for (const std::string& Comment : Global.Comments)
+			{
+				WriteComment(Sink, Span(Comment));
+				Out.push_back('\n');
+			}
+
+			for (const FProperty& Property : Global.Properties)
+			{
+				if (!IsWritable(Property))
+					continue;
+
+				WriteEntry(Sink, Property);
+				Out.push_back('\n');
+			}
+
+			if (!Out.empty())
+				Out.push_back('\n');
+
+			for (size_t SectionIndex = 0; SectionIndex < Sections.size(); ++SectionIndex)
+			{
+				const FSection& Section = Sections[SectionIndex];
+
+				WriteSectionHeader(Sink, Span(Section.Name));
+				Out.push_back('\n');
+
+				for (const std::string& Comment : Section.Comments)
+				{
+					WriteComment(Sink, Span(Comment));
+					Out.push_back('\n');
+				}
+
+				bool bFirstProperty = true;
+
+				for (const FProperty& Property : Section.Properties)
+				{
+					if (!IsWritable(Property))
+						continue;
+
+					if (!bFirstProperty)
+						Out.push_back('\n');
+
+					WriteEntry(Sink, Property);
+					bFirstProperty = false;
+				}
+
+				if (SectionIndex + 1 < Sections.size())
+					Out.append("\n\n");
+			}
+
+			return Out;
+		}
+
+	private:
+		std::unordered_map<std::string, size_t> Index;
+
+		struct FStringSink
+		{
+			std::string& Out;
+
+			void Write(const char* Data, size_t Len) { Out.append(Data, Len); }
+		};
+
+		struct FBuilder
+		{
+			FDocument& Document;
+			FSection* Current;
+
+			void OnComment(TSpan<char> Text)
+			{
+				Current->Comments.emplace_back(Text.Begin, Text.Len());
+			}
+
+			void OnSection(TSpan<char> Name)
+			{
+				Current = &Document.FindOrAddSection(std::string_view(Name.Begin, Name.Len()));
+			}
+
+			void OnProperty(TSpan<char> Key, TSpan<char> RawValue)
+			{
+				const EArrayOp ArrayOp = SplitArrayOp(Key);
+				const std::string_view Name(Key.Begin, Key.Len());
+
+				std::string Value;
+				DecodeValue(RawValue, [&Value](const char* Data, size_t Len) { Value.append(Data, Len); });
+
+				switch (ArrayOp)
+				{
+					case EArrayOp::None:
+						Current->FindOrAddProperty(Name, Value);
+						break;
+
+					case EArrayOp::Add:
+						Current->FindOrAddProperty(Name, std::string_view()).AddValue(Value);
+						break;
+
+					case EArrayOp::Remove:
+						if (FProperty* Property = Current->FindProperty(Name))
+							Property->RemoveValue(Value);
+						break;
+				}
+			}
+		};
+
+		static bool IsWritable(const FProperty& Property)
+		{
+			bool bWritable = IniParserCore::IsWritable(Span(Property.Value));
+
+			for (const std::string& Element : Property.Values)
+				bWritable &= IniParserCore::IsWritable(Span(Element));
+
+			return bWritable;
+		}
+
+		/** One "Key = Value" line, or one "+Key = Element" line per element, without the final newline */
+		static void WriteEntry(FStringSink& Sink, const FProperty& Property)
+		{
+			if (!Property.IsArray())
+			{
+				WriteProperty(Sink, Span(Property.Key), Span(Property.Value));
+				return;
+			}
+
+			for (size_t Index = 0; Index < Property.Values.size(); ++Index)
+			{
+				if (Index > 0)
+					Sink.Out.push_back('\n');
+
+				WriteArrayElement(Sink, Span(Property.Key), Span(Property.Values[Index]));
+			}
+		}
+
+		static TSpan<char> Span(const std::string& Text)
+		{
+			return { Text.data(), Text.data() + Text.size() };
+		}
+	};
+}
\ No newline at end of file
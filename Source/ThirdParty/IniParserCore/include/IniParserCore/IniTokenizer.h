@@ -0,0 +1,399 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/* Engine-independent .ini tokenizer. Works on any character type (char for UTF-8 tools, TCHAR inside Unreal) and reports tokens as spans into the source, so nothing is allocated or copied while scanning. */
+namespace IniParserCore
+{
+	/* Half-open range [Begin, End) inside the source text */
+	template <typename CharT>
+	struct TSpan
+	{
+		const CharT* Begin = nullptr;
+		const CharT* End = nullptr;
+
+		size_t Len() const { return static_cast<size_t>(End - Begin); }
+		bool IsEmpty() const { return Begin == End; }
+	};
+
+	/* Why a line was dropped or looks suspicious; see IniDiagnostics.h for messages */
+	enum class ELineError
+	{
+		/** "[Name" without ']' (error, line dropped) */
+		MissingSectionClose,
+
+		/** Text after the closing ']' (warning, ignored) */
+		TrailingTextAfterSection,
+
+		/** Neither a comment, a section nor "Key=Value" (error, line dropped) */
+		MissingEquals,
+
+		/** "=Value" (error, line dropped) */
+		EmptyKey,
+
+		/** Value opens with '"' that is never closed (error, the value is only its own line, kept as written) */
+		UnterminatedQuote,
+	};
+
+	/* What a property line does to an array; see SplitArrayOp */
+	enum class EArrayOp
+	{
+		/** "Key=Value", a plain value */
+		None,
+
+		/** "+Key=Value", append an element */
+		Add,
+
+		/** "-Key=Value", remove every element equal to the value */
+		Remove,
+	};
+
+	namespace Detail
+	{
+		/* True if the handler has OnError(ELineError, const CharT* At); only such handlers pay for error reporting */
+		template <typename HandlerT, typename CharT, typename = void>
+		struct THasOnError : std::false_type { };
+
+		template <typename HandlerT, typename CharT>
+		struct THasOnError<HandlerT, CharT, std::void_t<decltype(std::declval<HandlerT&>().OnError(ELineError(), static_cast<const CharT*>(nullptr)))>> : std::true_type { };
+	}
+
+	template <typename CharT>
+	inline bool IsWhitespace(CharT Char)
+	{
+		return Char == CharT(' ') || Char == CharT('\t') || Char == CharT('\r');
+	}
+
+	template <typename CharT>
+	inline TSpan<CharT> Trim(const CharT* Begin, const CharT* End)
+	{
+		while (Begin < End && IsWhitespace(*Begin))
+			++Begin;
+
+		while (End > Begin && IsWhitespace(*(End - 1)))
+			--End;
+
+		return { Begin, End };
+	}
+
+	template <typename CharT>
+	inline const CharT* Find(const CharT* Begin, const CharT* End, CharT Char)
+	{
+		while (Begin < End && *Begin != Char)
+			++Begin;
+
+		return Begin;
+	}
+
+	/* True if a trimmed value is an opening '"' with no other '"' after it on the line, so it may continue on the next lines */
+	template <typename CharT>
+	inline bool OpensMultiLineQuote(TSpan<CharT> Value)
+	{
+		return !Value.IsEmpty() && *Value.Begin == CharT('"') && Find(Value.Begin + 1, Value.End, CharT('"')) == Value.End;
+	}
+
+	/* True if a trimmed line is a property whose value opens a multi-line quote */
+	template <typename CharT>
+	inline bool IsMultiLineQuoteLine(TSpan<CharT> Line)
+	{
+		if (Line.IsEmpty() || *Line.Begin == CharT(';') || *Line.Begin == CharT('['))
+			return false;
+
+		const CharT* Equals = Find(Line.Begin, Line.End, CharT('='));
+
+		return Equals != Line.End && Equals != Line.Begin && OpensMultiLineQuote(Trim(Equals + 1, Line.End));
+	}
+
+	/**
+	 * Find the end of the entry that starts at Begin. Usually that is the end of the line, but a property value continues
+	 *   - over the following lines up to the one ending with '"', if it opens a quote (see OpensMultiLineQuote). A section
+	 *     header, another line opening a quote or the end of the text before that means the quote is never closed, and the
+	 *     entry is only its first line;
+	 *   - onto the next line, if the line ends with '\' and the next line is indented (unindented lines are never swallowed).
+	 *
+	 * @param OUT bOutNeedsMore Set if the answer could change once text after End is known (see TokenizeComplete)
+	 * @return The '\n' that ends the entry, or End
+	 */
+	template <typename CharT>
+	inline const CharT* FindEntryEnd(const CharT* Begin, const CharT* End, bool& bOutNeedsMore)
+	{
+		bOutNeedsMore = false;
+
+		const CharT* LineEnd = Find(Begin, End, CharT('\n'));
+		const TSpan<CharT> Line = Trim(Begin, LineEnd);
+
+		if (Line.IsEmpty() || *Line.Begin == CharT(';') || *Line.Begin == CharT('['))
+			return LineEnd;
+
+		const CharT* Equals = Find(Line.Begin, Line.End, CharT('='));
+
+		if (Equals == Line.End || Equals == Line.Begin)
+			return LineEnd;
+
+		TSpan<CharT> Value = Trim(Equals + 1, Line.End);
+
+		if (OpensMultiLineQuote(Value))
+		{
+			for (const CharT* Cursor = LineEnd; Cursor < End;)
+			{
+				const CharT* NextEnd = Find(Cursor + 1, End, CharT('\n'));
+				const TSpan<CharT> Next = Trim(Cursor + 1, NextEnd);
+
+				// A line cut off by End may still become another kind of line.
+				bOutNeedsMore = NextEnd == End;
+
+				if (!Next.IsEmpty() && *Next.Begin == CharT('['))
+					return LineEnd;
+
+				if (!Next.IsEmpty() && *(Next.End - 1) == CharT('"'))
+					return NextEnd;
+
+				if (IsMultiLineQuoteLine(Next))
+					return LineEnd;
+
+				Cursor = NextEnd;
+			}
+
+			bOutNeedsMore = true;
+			return LineEnd;
+		}
+
+		while (!Value.IsEmpty() && *(Value.End - 1) == CharT('\\') && End - LineEnd > 1 && (LineEnd[1] == CharT(' ') || LineEnd[1] == CharT('\t')))
+		{
+			const CharT* NextEnd = Find(LineEnd + 1, End, CharT('\n'));
+
+			Value = Trim(LineEnd + 1, NextEnd);
+			LineEnd = NextEnd;
+		}
+
+		return LineEnd;
+	}
+
+	template <typename CharT>
+	inline const CharT* FindEntryEnd(const CharT* Begin, const CharT* End)
+	{
+		bool bNeedsMore;
+		return FindEntryEnd(Begin, End, bNeedsMore);
+	}
+
+	/**
+	 * Split the array operation off a property key: "+Key" appends, "-Key" removes. A lone "+" or "-" stays a key.
+	 *
+	 * @param Key Trimmed key, advanced past the operator
+	 */
+	template <typename CharT>
+	inline EArrayOp SplitArrayOp(TSpan<CharT>& Key)
+	{
+		if (Key.Len() < 2)
+			return EArrayOp::None;
+
+		if (*Key.Begin == CharT('+'))
+		{
+			++Key.Begin;
+			return EArrayOp::Add;
+		}
+
+		if (*Key.Begin == CharT('-'))
+		{
+			++Key.Begin;
+			return EArrayOp::Remove;
+		}
+
+		return EArrayOp::None;
+	}
+
+	/**
+	 * Turn a raw value into the stored value. Only the enclosing quotes are removed; quotes inside the value are kept.
+	 *   "..."  Everything between the quotes is kept as written, including newlines of a multi-line value ('\r' before a newline is dropped).
+	 *          A value that opens with '"' but does not end with one is kept as written, quote included.
+	 *   '...'  Quotes removed, then continuations joined as below. Same for "..." spanning lines without opening a quote on its first line.
+	 *   Other  Every "\\" line end is joined with the next line, dropping the backslash and the next line's indentation.
+	 *
+	 * @param Value Raw value span, as reported by OnProperty
+	 * @param Append Invoked as Append(const CharT* Data, size_t Len) for every run of the result
+	 */
+	template <typename CharT, typename AppendT>
+	inline void DecodeValue(TSpan<CharT> Value, AppendT&& Append)
+	{
+		if (Value.IsEmpty())
+			return;
+
+		const bool bDoubleQuoted = Value.Len() >= 2 && *Value.Begin == CharT('"') && *(Value.End - 1) == CharT('"');
+		const CharT* FirstLineEnd = Find(Value.Begin, Value.End, CharT('\n'));
+
+		// Only a quote opened on the first line keeps newlines; otherwise the lines were joined by '\\' continuations.
+		if (bDoubleQuoted && (FirstLineEnd == Value.End || OpensMultiLineQuote(Trim(Value.Begin, FirstLineEnd))))
+		{
+			const CharT* Begin = Value.Begin + 1;
+			const CharT* End = Value.End - 1;
+			const CharT* RunStart = Begin;
+
+			for (const CharT* Char = Find(Begin, End, CharT('\n')); Char < End; Char = Find(Char + 1, End, CharT('\n')))
+			{
+				const CharT* RunEnd = Char;
+
+				while (RunEnd > RunStart && *(RunEnd - 1) == CharT('\r'))
+					--RunEnd;
+
+				if (RunEnd > RunStart)
+					Append(RunStart, static_cast<size_t>(RunEnd - RunStart));
+
+				RunStart = Char;
+			}
+
+			if (End > RunStart)
+				Append(RunStart, static_cast<size_t>(End - RunStart));
+
+			return;
+		}
+
+		if (bDoubleQuoted || (Value.Len() >= 2 && *Value.Begin == CharT('\'') && *(Value.End - 1) == CharT('\'')))
+		{
+			++Value.Begin;
+			--Value.End;
+		}
+
+		const CharT* RunStart = Value.Begin;
+
+		for (const CharT* Newline = Find(RunStart, Value.End, CharT('\n')); Newline < Value.End; Newline = Find(RunStart, Value.End, CharT('\n')))
+		{
+			// FindEntryEnd only continues lines that end with a backslash, possibly followed by whitespace.
+			const CharT* RunEnd = Newline;
+
+			while (RunEnd > RunStart && IsWhitespace(*(RunEnd - 1)))
+				--RunEnd;
+
+			if (RunEnd > RunStart && *(RunEnd - 1) == CharT('\\'))
+				--RunEnd;
+
+			if (RunEnd > RunStart)
+				Append(RunStart, static_cast<size_t>(RunEnd - RunStart));
+
+			RunStart = Newline + 1;
+
+			while (RunStart < Value.End && IsWhitespace(*RunStart))
+				++RunStart;
+		}
+
+		if (Value.End > RunStart)
+			Append(RunStart, static_cast<size_t>(Value.End - RunStart));
+	}
+
+	/**
+	 * Scan one entry (a line without its newline, or several lines as found by FindEntryEnd) and report what it contains.
+	 * Handlers that define OnError(ELineError, const CharT* At) are also told about malformed lines; for all others the checks compile away.
+	 */
+	template <typename CharT, typename HandlerT>
+	inline void TokenizeLine(const CharT* Begin, const CharT* End, HandlerT& Handler)
+	{
+		const TSpan<CharT> Line = Trim(Begin, End);
+
+		if (Line.IsEmpty())
+			return;
+
+		switch (*Line.Begin)
+		{
+			case CharT(';'):
+				Handler.OnComment(Trim(Line.Begin + 1, Line.End));
+				return;
+
+			case CharT('['):
+			{
+				const CharT* Close = Find(Line.Begin + 1, Line.End, CharT(']'));
+
+				// A section header without ']' is dropped.
+				if (Close == Line.End)
+				{
+					if constexpr (Detail::THasOnError<HandlerT, CharT>::value)
+						Handler.OnError(ELineError::MissingSectionClose, Line.End);
+
+					return;
+				}
+
+				if constexpr (Detail::THasOnError<HandlerT, CharT>::value)
+				{
+					if (!Trim(Close + 1, Line.End).IsEmpty())
+						Handler.OnError(ELineError::TrailingTextAfterSection, Trim(Close + 1, Line.End).Begin);
+				}
+
+				Handler.OnSection(Trim(Line.Begin + 1, Close));
+				return;
+			}
+
+			default:
+			{
+				const CharT* Equals = Find(Line.Begin, Line.End, CharT('='));
+
+				// Lines without '=' or without a key are dropped.
+				if (Equals == Line.End || Equals == Line.Begin)
+				{
+					if constexpr (Detail::THasOnError<HandlerT, CharT>::value)
+						Handler.OnError(Equals == Line.End ? ELineError::MissingEquals : ELineError::EmptyKey, Equals == Line.End ? Line.Begin : Equals);
+
+					return;
+				}
+
+				if constexpr (Detail::THasOnError<HandlerT, CharT>::value)
+				{
+					if (OpensMultiLineQuote(Trim(Equals + 1, Line.End)))
+						Handler.OnError(ELineError::UnterminatedQuote, Trim(Equals + 1, Line.End).Begin);
+				}
+
+				Handler.OnProperty(Trim(Line.Begin, Equals), Trim(Equals + 1, Line.End));
+				return;
+			}
+		}
+	}
+
+	/**
+	 * Tokenize .ini text. The handler receives:
+	 *   OnComment(TSpan<CharT> Text)
+	 *   OnSection(TSpan<CharT> Name)
+	 *   OnProperty(TSpan<CharT> Key, TSpan<CharT> RawValue)
+	 * Spans are trimmed and point into [Begin, End). Keys still carry their array operator (see SplitArrayOp) and
+	 * values their quotes and continuations (see DecodeValue), so tokenizing never copies.
+	 */
+	template <typename CharT, typename HandlerT>
+	inline void Tokenize(const CharT* Begin, const CharT* End, HandlerT& Handler)
+	{
+		const CharT* Cursor = Begin;
+
+		while (Cursor < End)
+		{
+			const CharT* EntryEnd = FindEntryEnd(Cursor, End);
+			TokenizeLine(Cursor, EntryEnd, Handler);
+			Cursor = EntryEnd < End ? EntryEnd + 1 : End;
+		}
+	}
+
+	/**
+	 * Tokenize the entries of [Begin, End) that are known to be complete, for text that continues after End (e.g. a decoded chunk).
+	 * An entry counts as complete once the first character of the line after it is available, and a quoted value once
+	 * its end no longer depends on the lines after End.
+	 *
+	 * @return Start of the unfinished tail, to be tokenized again together with the following text
+	 */
+	template <typename CharT, typename HandlerT>
+	inline const CharT* TokenizeComplete(const CharT* Begin, const CharT* End, HandlerT& Handler)
+	{
+		const CharT* Cursor = Begin;
+
+		while (Cursor < End)
+		{
+			bool bNeedsMore;
+			const CharT* EntryEnd = FindEntryEnd(Cursor, End, bNeedsMore);
+
+			if (bNeedsMore || End - EntryEnd < 2)
+				break;
+
+			TokenizeLine(Cursor, EntryEnd, Handler);
+			Cursor = EntryEnd + 1;
+		}
+
+		return Cursor;
+	}
+}
\ No newline at end of file
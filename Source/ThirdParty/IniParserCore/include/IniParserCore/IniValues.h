@@ -0,0 +1,482 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if __has_include(<charconv>)
+	#include <charconv>
+#endif
+
+// Shortest round-trip std::to_chars for floating point (Ryu-based in MSVC, libstdc++ and libc++). libc++ does not define
+// the feature macro because from_chars is incomplete, and Apple's system libc++ only ships it from macOS 13.3.
+#if defined(__cpp_lib_to_chars) || (defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 14000 && !defined(__APPLE__))
+	#define INIPARSERCORE_SHORTEST_TO_CHARS 1
+#else
+	#define INIPARSERCORE_SHORTEST_TO_CHARS 0
+#endif
+
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	#define INIPARSERCORE_LITTLE_ENDIAN 1
+#else
+	#define INIPARSERCORE_LITTLE_ENDIAN 0
+#endif
+
+/* Engine-independent parsers and formatters for property values. Work on any character type, like the tokenizer, and only allocate for number tokens of 64 characters or more. */
+namespace IniParserCore
+{
+	namespace Detail
+	{
+		// Powers of ten that are exactly representable as a double.
+		static constexpr double EXACT_POWERS_OF_TEN[] =
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		static constexpr uint64_t MAX_EXACT_MANTISSA = 1ull << 53;
+		static constexpr int MAX_SIGNIFICANT_DIGITS = 19;
+
+		template <typename CharT>
+		inline bool IsDigit(CharT Char)
+		{
+			return Char >= CharT('0') && Char <= CharT('9');
+		}
+
+		template <typename CharT>
+		inline bool IsValueWhitespace(CharT Char)
+		{
+			return Char == CharT(' ') || Char == CharT('\t') || Char == CharT('\r') || Char == CharT('\n');
+		}
+
+		template <typename CharT>
+		inline void SkipWhitespace(const CharT*& Cursor, const CharT* End)
+		{
+			while (Cursor < End && IsValueWhitespace(*Cursor))
+				++Cursor;
+		}
+
+		/**
+		 * Read a block of decimal digits at once. On little-endian targets the characters are loaded into one 64-bit word,
+		 * validated and combined with SWAR arithmetic: eight digits for 1-byte characters, four for UTF-16.
+		 *
+		 * @return Number of digits in the block (0 if any character is not a digit)
+		 */
+		template <typename CharT>
+		inline int ReadDigitBlock(const CharT* Cursor, const CharT* End, uint32_t& OutValue)
+		{
+#if INIPARSERCORE_LITTLE_ENDIAN
+			if constexpr (sizeof(CharT) == 1)
+			{
+				if (End - Cursor < 8)
+					return 0;
+
+				uint64_t Chunk;
+				std::memcpy(&Chunk, Cursor, sizeof(Chunk));
+
+				// Every lane must be in ['0', '9']: high nibble 3 and no carry out of the low nibble when adding 6.
+				if (((Chunk & 0xF0F0F0F0F0F0F0F0ull) | (((Chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) != 0x3333333333333333ull)
+					return 0;
+
+				Chunk -= 0x3030303030303030ull;
+				Chunk = (Chunk * 10 + (Chunk >> 8)) & 0x00FF00FF00FF00FFull;
+				Chunk = (Chunk * 100 + (Chunk >> 16)) & 0x0000FFFF0000FFFFull;
+				OutValue = static_cast<uint32_t>((Chunk * 10000 + (Chunk >> 32)) & 0xFFFFFFFFull);
+				return 8;
+			}
+
+			if constexpr (sizeof(CharT) == 2)
+			{
+				if (End - Cursor < 4)
+					return 0;
+
+				uint64_t Chunk;
+				std::memcpy(&Chunk, Cursor, sizeof(Chunk));
+
+				// Same check on 16-bit lanes, whose high byte must also be clear.
+				if ((Chunk & 0xFF00FF00FF00FF00ull) != 0)
+					return 0;
+
+				if (((Chunk & 0x00F000F000F000F0ull) | (((Chunk + 0x0006000600060006ull) & 0x00F000F000F000F0ull) >> 4)) != 0x0033003300330033ull)
+					return 0;
+
+				Chunk -= 0x0030003000300030ull;
+				Chunk = (Chunk * 10 + (Chunk >> 16)) & 0x0000FFFF0000FFFFull;
+				OutValue = static_cast<uint32_t>((Chunk * 100 + (Chunk >> 32)) & 0xFFFF);
+				return 4;
+			}
+#endif
+
+			if (End - Cursor < 4 || !IsDigit(Cursor[0]) || !IsDigit(Cursor[1]) || !IsDigit(Cursor[2]) || !IsDigit(Cursor[3]))
+				return 0;
+
+			OutValue = static_cast<uint32_t>((Cursor[0] - CharT('0')) * 1000 + (Cursor[1] - CharT('0')) * 100 + (Cursor[2] - CharT('0')) * 10 + (Cursor[3] - CharT('0')));
+			return 4;
+		}
+
+		template <typename CharT>
+		inline bool ParseUnsigned(const CharT*& Cursor, const CharT* End, uint64_t Limit, uint64_t& OutValue)
+		{
+			static constexpr uint32_t BLOCK_SCALE[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+			const CharT* Start = Cursor;
+			uint64_t Result = 0;
+
+			uint32_t Block;
+
+			for (int NumDigits = ReadDigitBlock(Cursor, End, Block); NumDigits > 0; NumDigits = ReadDigitBlock(Cursor, End, Block))
+			{
+				if (Result > (Limit - Block) / BLOCK_SCALE[NumDigits])
+					return false;
+
+				Result = Result * BLOCK_SCALE[NumDigits] + Block;
+				Cursor += NumDigits;
+			}
+
+			while (Cursor < End && IsDigit(*Cursor))
+			{
+				const uint32_t Digit = static_cast<uint32_t>(*Cursor - CharT('0'));
+
+				if (Result > (Limit - Digit) / 10)
+					return false;
+
+				Result = Result * 10 + Digit;
+				++Cursor;
+			}
+
+			OutValue = Result;
+			return Cursor != Start;
+		}
+	}
+
+	/**
+	 * Parse a signed integer token at the cursor and advance past it
+	 *
+	 * @param Cursor Advanced past the token on success
+	 * @param Min, Max Range of the target type; values outside fail
+	 * @return True if a number was read
+	 */
+	template <typename CharT>
+	inline bool ParseIntegerToken(const CharT*& Cursor, const CharT* End, int64_t Min, int64_t Max, int64_t& OutValue)
+	{
+		const CharT* Char = Cursor;
+		bool bNegative = false;
+
+		if (Char < End && (*Char == CharT('-') || *Char == CharT('+')))
+		{
+			bNegative = *Char == CharT('-');
+			++Char;
+		}
+
+		const uint64_t Limit = bNegative ? static_cast<uint64_t>(-(Min + 1)) + 1 : static_cast<uint64_t>(Max);
+
+		uint64_t Magnitude;
+
+		if (!Detail::ParseUnsigned(Char, End, Limit, Magnitude))
+			return false;
+
+		Cursor = Char;
+		OutValue = bNegative ? static_cast<int64_t>(0 - Magnitude) : static_cast<int64_t>(Magnitude);
+		return true;
+	}
+
+	/**
+	 * Parse a decimal number token ("-1.5e3", ".5", "5.") at the cursor and advance past it. Results are correctly rounded:
+	 * short inputs take Clinger's exact fast path, everything else goes through strtod.
+	 *
+	 * @param Cursor Advanced past the token on success
+	 * @return True if a number was read
+	 */
+	template <typename CharT>
+	inline bool ParseNumberToken(const CharT*& Cursor, const CharT* End, double& OutValue)
+	{
+		using namespace Detail;
+
+		const CharT* Start = Cursor;
+		const CharT* Char = Cursor;
+
+		bool bNegative = false;
+
+		if (Char < End && (*Char == CharT('-') || *Char == CharT('+')))
+		{
+			bNegative = *Char == CharT('-');
+			++Char;
+		}
+
+		uint64_t Mantissa = 0;
+		int NumSignificantDigits = 0;
+		int Exponent = 0;
+		bool bHasDigits = false;
+		bool bTruncated = false;
+
+		auto ConsumeDigit = [&](CharT Digit, bool bFraction)
+		{
+			bHasDigits = true;
+
+			if (Mantissa == 0 && Digit == CharT('0'))
+			{
+				Exponent -= bFraction ? 1 : 0;
+				return;
+			}
+
+			if (NumSignificantDigits < MAX_SIGNIFICANT_DIGITS)
+			{
+				Mantissa = Mantissa * 10 + static_cast<uint64_t>(Digit - CharT('0'));
+				NumSignificantDigits++;
+				Exponent -= bFraction ? 1 : 0;
+			}
+			else
+			{
+				bTruncated = true;
+				Exponent += bFraction ? 0 : 1;
+			}
+		};
+
+		while (Char < End && IsDigit(*Char))
+			ConsumeDigit(*Char++, false);
+
+		if (Char < End && *Char == CharT('.'))
+		{
+			++Char;
+
+			while (Char < End && IsDigit(*Char))
+				ConsumeDigit(*Char++, true);
+		}
+
+		if (!bHasDigits)
+			return false;
+
+		if (Char < End && (*Char == CharT('e') || *Char == CharT('E')))
+		{
+			const CharT* ExponentChar = Char + 1;
+			bool bNegativeExponent = false;
+
+			if (ExponentChar < End && (*ExponentChar == CharT('-') || *ExponentChar == CharT('+')))
+			{
+				bNegativeExponent = *ExponentChar == CharT('-');
+				++ExponentChar;
+			}
+
+			// "1e" is a number followed by garbage, not a malformed exponent.
+			if (ExponentChar < End && IsDigit(*ExponentChar))
+			{
+				int ExplicitExponent = 0;
+
+				while (ExponentChar < End && IsDigit(*ExponentChar))
+				{
+					if (ExplicitExponent < 100000)
+						ExplicitExponent = ExplicitExponent * 10 + static_cast<int>(*ExponentChar - CharT('0'));
+
+					++ExponentChar;
+				}
+
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+				Char = ExponentChar;
+			}
+		}
+
+		Cursor = Char;
+
+		// Clinger's fast path: mantissa and power of ten are both exact, so one IEEE operation rounds correctly.
+		if (!bTruncated && Mantissa <= MAX_EXACT_MANTISSA && Exponent >= -22 && Exponent <= 22)
+		{
+			double Value = static_cast<double>(Mantissa);
+			Value = Exponent < 0 ? Value / EXACT_POWERS_OF_TEN[-Exponent] : Value * EXACT_POWERS_OF_TEN[Exponent];
+			OutValue = bNegative ? -Value : Value;
+			return true;
+		}
+
+		// Long mantissas and large exponents need arbitrary precision; the CRT is correctly rounded for those.
+		// The token only holds ASCII digits, signs, '.' and 'e', so narrowing is exact.
+		char Narrow[64];
+		std::string Long;
+		const size_t Len = static_cast<size_t>(Char - Start);
+		char* Buffer = Len < sizeof(Narrow) ? Narrow : (Long.resize(Len + 1), &Long[0]);
+
+		for (size_t Index = 0; Index < Len; ++Index)
+			Buffer[Index] = static_cast<char>(Start[Index]);
+
+		Buffer[Len] = '\0';
+		OutValue = std::strtod(Buffer, nullptr);
+		return true;
+	}
+
+	/**
+	 * Parse a whole value as a signed integer. Surrounding whitespace is allowed, anything else fails.
+	 *
+	 * @return True if the value is a valid integer within [Min, Max]
+	 */
+	template <typename CharT>
+	inline bool ParseIntegerValue(const CharT* Begin, const CharT* End, int64_t Min, int64_t Max, int64_t& OutValue)
+	{
+		Detail::SkipWhitespace(Begin, End);
+
+		if (!ParseIntegerToken(Begin, End, Min, Max, OutValue))
+			return false;
+
+		Detail::SkipWhitespace(Begin, End);
+		return Begin == End;
+	}
+
+	/**
+	 * Parse a whole value as a decimal number. Surrounding whitespace is allowed, anything else fails.
+	 *
+	 * @return True if the value is a valid decimal number
+	 */
+	template <typename CharT>
+	inline bool ParseNumberValue(const CharT* Begin, const CharT* End, double& OutValue)
+	{
+		Detail::SkipWhitespace(Begin, End);
+
+		if (!ParseNumberToken(Begin, End, OutValue))
+			return false;
+
+		Detail::SkipWhitespace(Begin, End);
+		return Begin == End;
+	}
+
+	/**
+	 * Parse a component literal such as "X=1 Y=2 Z=3" or "(R=1,G=0,B=0)" in one pass. Keys are single upper-case ASCII
+	 * characters, matched case-insensitively, and must appear in order. Components are separated by whitespace or commas.
+	 *
+	 * @param Keys One character per component, e.g. "XYZ"
+	 * @param OutValues NumKeys values; optional components that are missing keep their value
+	 * @param NumRequired Components after this many may be left out
+	 * @return True if the whole value was parsed
+	 */
+	template <typename CharT>
+	inline bool ParseComponents(const CharT* Begin, const CharT* End, const char* Keys, double* OutValues, int NumKeys, int NumRequired)
+	{
+		auto SkipSeparators = [End](const CharT*& Cursor)
+		{
+			while (Cursor < End && (Detail::IsValueWhitespace(*Cursor) || *Cursor == CharT(',')))
+				++Cursor;
+		};
+
+		const CharT* Cursor = Begin;
+		Detail::SkipWhitespace(Cursor, End);
+
+		if (Cursor < End && *Cursor == CharT('('))
+			++Cursor;
+
+		for (int Index = 0; Index < NumKeys; ++Index)
+		{
+			SkipSeparators(Cursor);
+
+			if (Index >= NumRequired && (Cursor == End || *Cursor == CharT(')')))
+				break;
+
+			if (Cursor == End || (*Cursor != CharT(Keys[Index]) && *Cursor != CharT(Keys[Index] - 'A' + 'a')))
+				return false;
+
+			++Cursor;
+
+			if (Cursor == End || *Cursor != CharT('='))
+				return false;
+
+			++Cursor;
+
+			if (!ParseNumberToken(Cursor, End, OutValues[Index]))
+				return false;
+		}
+
+		SkipSeparators(Cursor);
+
+		if (Cursor < End && *Cursor == CharT(')'))
+			++Cursor;
+
+		Detail::SkipWhitespace(Cursor, End);
+		return Cursor == End;
+	}
+
+	/** Large enough for any formatted double, including sign, exponent and the ".0" suffix */
+	static constexpr int MAX_NUMBER_LENGTH = 32;
+
+	namespace Detail
+	{
+		/**
+		 * Shortest "%.*g" text that reads back as the same value, found by raising the precision from the type's guaranteed
+		 * decimal digits (a value with a shorter exact form already prints as that form there, since %g drops trailing zeros).
+		 * Exact, but costs up to three formats and parses per value; only used where std::to_chars is missing.
+		 */
+		template <typename T>
+		inline int FormatBySearch(T Value, int MinPrecision, int MaxPrecision, char* Buffer)
+		{
+			int Len = 0;
+
+			for (int Precision = MinPrecision; Precision <= MaxPrecision; ++Precision)
+			{
+				Len = std::snprintf(Buffer, MAX_NUMBER_LENGTH, "%.*g", Precision, static_cast<double>(Value));
+
+				const char* Cursor = Buffer;
+				double Parsed;
+
+				if (Precision == MaxPrecision || (ParseNumberToken(Cursor, Buffer + Len, Parsed) && Cursor == Buffer + Len && static_cast<T>(Parsed) == Value))
+					break;
+			}
+
+			return Len;
+		}
+
+		template <typename T>
+		inline int FormatShortest(T Value, bool bUseSearch, int MinPrecision, int MaxPrecision, char* Buffer)
+		{
+			if (Value != Value || Value - Value != T(0))
+				return std::snprintf(Buffer, MAX_NUMBER_LENGTH, "%g", static_cast<double>(Value));
+
+#if INIPARSERCORE_SHORTEST_TO_CHARS
+			int Len = 0;
+
+			if (bUseSearch)
+				Len = FormatBySearch(Value, MinPrecision, MaxPrecision, Buffer);
+			else
+			{
+				// Shortest scientific gives the digit count; printing %g-style at that precision (never below MinPrecision)
+				// picks the same notation and digits as the search, which stops at the first round-tripping precision.
+				const char* Last = std::to_chars(Buffer, Buffer + MAX_NUMBER_LENGTH, Value, std::chars_format::scientific).ptr;
+				const char* Exponent = static_cast<const char*>(std::memchr(Buffer, 'e', Last - Buffer));
+				const int NumDigits = static_cast<int>(Exponent - Buffer) - (Value < T(0)) - (Exponent - Buffer > 1 + (Value < T(0)));
+				const int Precision = NumDigits > MinPrecision ? NumDigits : MinPrecision;
+
+				Len = static_cast<int>(std::to_chars(Buffer, Buffer + MAX_NUMBER_LENGTH, Value, std::chars_format::general, Precision).ptr - Buffer);
+			}
+#else
+			(void)bUseSearch;
+			int Len = FormatBySearch(Value, MinPrecision, MaxPrecision, Buffer);
+#endif
+
+			// Keep integral values recognisable as decimals ("1.0" rather than "1"), like FString::SanitizeFloat.
+			if (std::memchr(Buffer, '.', Len) == nullptr && std::memchr(Buffer, 'e', Len) == nullptr)
+			{
+				Buffer[Len++] = '.';
+				Buffer[Len++] = '0';
+			}
+
+			Buffer[Len] = '\0';
+			return Len;
+		}
+	}
+
+	/**
+	 * Format a double with the fewest significant digits that read back bit-exact (through ParseNumberToken or strtod).
+	 * Uses std::to_chars where the standard library has it, the exact precision search otherwise.
+	 *
+	 * @param Buffer At least MAX_NUMBER_LENGTH characters
+	 * @param bUseSearch Force the precision search (for tests and benchmarks)
+	 * @return Number of characters written, not counting the null terminator
+	 */
+	inline int FormatDouble(double Value, char* Buffer, bool bUseSearch = false)
+	{
+		return Detail::FormatShortest(Value, bUseSearch, 15, 17, Buffer);
+	}
+
+	/** FormatDouble for floats: the fewest digits that read back as the same float */
+	inline int FormatFloat(float Value, char* Buffer, bool bUseSearch = false)
+	{
+		return Detail::FormatShortest(Value, bUseSearch, 6, 9, Buffer);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+// Copyright 2023 MrRobin. All Rights Reserved.
+
+#pragma once
+
+#include "IniParserCore/IniTokenizer.h"
+
+/* Engine-independent .ini line writers. The sink only needs Write(const CharT* Data, size_t Len), so the same code writes into std::string and FStringBuilder. */
+namespace IniParserCore
+{
+	/**
+	 * Decide whether a value has to be quoted so that DecodeValue gives it back unchanged: it contains whitespace the tokenizer
+	 * would trim, ';' or a newline, starts with a quote (which would be taken as the value's own quoting) or ends with '\\'.
+	 * Single pass without early exit, so the loop stays branch-free and vectorizes.
+	 * Not every multi-line value can be represented even when quoted, see IsWritable.
+	 */
+	template <typename CharT>
+	inline bool NeedsQuotes(TSpan<CharT> Value)
+	{
+		if (Value.IsEmpty())
+			return false;
+
+		bool bFound = *Value.Begin == CharT('"') || *Value.Begin == CharT('\'') || *(Value.End - 1) == CharT('\\');
+
+		for (const CharT* Char = Value.Begin; Char < Value.End; ++Char)
+			bFound |= (*Char == CharT(' ')) | (*Char == CharT('\t')) | (*Char == CharT('\r')) | (*Char == CharT('\n')) | (*Char == CharT(';'));
+
+		return bFound;
+	}
+
+	/**
+	 * Decide whether a value reads back unchanged once written. Only multi-line values can fail: their lines are written as
+	 * they are, so FindEntryEnd must not end the value early. The first line may not contain '"', no later line may start
+	 * with '[' or be a property opening a quote, and no line before the last may end with '"'. Parsed values always pass;
+	 * there is no escape syntax for the others, so writers leave them out.
+	 */
+	template <typename CharT>
+	inline bool IsWritable(TSpan<CharT> Value)
+	{
+		const CharT* LineEnd = Find(Value.Begin, Value.End, CharT('\n'));
+
+		if (LineEnd == Value.End)
+			return true;
+
+		if (Find(Value.Begin, LineEnd, CharT('"')) != LineEnd)
+			return false;
+
+		while (LineEnd < Value.End)
+		{
+			const CharT* NextEnd = Find(LineEnd + 1, Value.End, CharT('\n'));
+			const TSpan<CharT> Line = Trim(LineEnd + 1, NextEnd);
+
+			if (!Line.IsEmpty() && *Line.Begin == CharT('['))
+				return false;
+
+			// The last line is followed by the closing quote, which makes it end with '"' and never open a quote.
+			if (NextEnd < Value.End && ((!Line.IsEmpty() && *(Line.End - 1) == CharT('"')) || IsMultiLineQuoteLine(Line)))
+				return false;
+
+			LineEnd = NextEnd;
+		}
+
+		return true;
+	}
+
+	template <typename CharT, typename SinkT>
+	inline void WriteChar(SinkT& Sink, CharT Char)
+	{
+		Sink.Write(&Char, 1);
+	}
+
+	template <typename CharT, typename SinkT>
+	inline void WriteSpan(SinkT& Sink, TSpan<CharT> Text)
+	{
+		if (!Text.IsEmpty())
+			Sink.Write(Text.Begin, Text.Len());
+	}
+
+	/** "; Comment" without newline */
+	template <typename CharT, typename SinkT>
+	inline void WriteComment(SinkT& Sink, TSpan<CharT> Text)
+	{
+		WriteChar(Sink, CharT(';'));
+		WriteChar(Sink, CharT(' '));
+		WriteSpan(Sink, Text);
+	}
+
+	/** "[Name]" without newline */
+	template <typename CharT, typename SinkT>
+	inline void WriteSectionHeader(SinkT& Sink, TSpan<CharT> Name)
+	{
+		WriteChar(Sink, CharT('['));
+		WriteSpan(Sink, Name);
+		WriteChar(Sink, CharT(']'));
+	}
+
+	/** " = Value" without newline. Values that need it are quoted. */
+	template <typename CharT, typename SinkT>
+	inline void WriteAssignment(SinkT& Sink, TSpan<CharT> Value)
+	{
+		WriteChar(Sink, CharT(' '));
+		WriteChar(Sink, CharT('='));
+		WriteChar(Sink, CharT(' '));
+
+		if (NeedsQuotes(Value))
+		{
+			WriteChar(Sink, CharT('"'));
+			WriteSpan(Sink, Value);
+			WriteChar(Sink, CharT('"'));
+		}
+		else
+			WriteSpan(Sink, Value);
+	}
+
+	/** "Key = Value" without newline */
+	template <typename CharT, typename SinkT>
+	inline void WriteProperty(SinkT& Sink, TSpan<CharT> Key, TSpan<CharT> Value)
+	{
+		WriteSpan(Sink, Key);
+		WriteAssignment(Sink, Value);
+	}
+
+	/** "+Key = Value" without newline, one element of an array property */
+	template <typename CharT, typename SinkT>
+	inline void WriteArrayElement(SinkT& Sink, TSpan<CharT> Key, TSpan<CharT> Value)
+	{
+		WriteChar(Sink, CharT('+'));
+		WriteProperty(Sink, Key, Value);
+	}
+}
\ No newline at end of file